@@ -0,0 +1,77 @@
+#include "alloc_tracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<int> current_phase(ALLOC_PHASE_STARTUP);
+static std::atomic<size_t> phase_counts[ALLOC_NUM_PHASES];
+static std::atomic<size_t> phase_bytes[ALLOC_NUM_PHASES];
+
+bool alloc_tracking_enabled()
+{
+#ifdef SIC_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void alloc_phase_set(AllocPhase phase)
+{
+    current_phase.store(phase, std::memory_order_relaxed);
+}
+
+AllocStats alloc_phase_stats(AllocPhase phase)
+{
+    AllocStats stats;
+    stats.count = phase_counts[phase].load(std::memory_order_relaxed);
+    stats.bytes = phase_bytes[phase].load(std::memory_order_relaxed);
+    return stats;
+}
+
+void alloc_tracker_report(FILE *file)
+{
+    static const char *phase_names[ALLOC_NUM_PHASES] = {"startup", "frame", "shutdown"};
+
+    if (!alloc_tracking_enabled())
+    {
+        fprintf(file, "allocation tracking disabled (build with SIC_TRACK_ALLOCATIONS)\n");
+        return;
+    }
+
+    for (int phase = 0; phase < ALLOC_NUM_PHASES; ++phase)
+    {
+        AllocStats stats = alloc_phase_stats((AllocPhase)phase);
+        fprintf(file, "%-8s %8zu allocations %10zu bytes\n", phase_names[phase], stats.count, stats.bytes);
+    }
+}
+
+#ifdef SIC_TRACK_ALLOCATIONS
+
+// Replacements for the global allocation functions. The nothrow and array
+// forms default to these, so they are enough to see every new expression.
+
+void *operator new(size_t size)
+{
+    int phase = current_phase.load(std::memory_order_relaxed);
+    phase_counts[phase].fetch_add(1, std::memory_order_relaxed);
+    phase_bytes[phase].fetch_add(size, std::memory_order_relaxed);
+
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+#endif
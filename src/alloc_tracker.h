@@ -0,0 +1,28 @@
+#pragma once
+
+// Heap allocation counters, kept per phase of the program. Only active when
+// built with SIC_TRACK_ALLOCATIONS, which replaces the global operator new;
+// otherwise every count stays zero. malloc calls made by C libraries such as
+// GLFW or the GL driver are not seen.
+
+#include <cstddef>
+#include <cstdio>
+
+enum AllocPhase
+{
+    ALLOC_PHASE_STARTUP = 0,
+    ALLOC_PHASE_FRAME = 1,
+    ALLOC_PHASE_SHUTDOWN = 2,
+    ALLOC_NUM_PHASES = 3
+};
+
+struct AllocStats
+{
+    size_t count;
+    size_t bytes;
+};
+
+bool alloc_tracking_enabled();
+void alloc_phase_set(AllocPhase phase);
+AllocStats alloc_phase_stats(AllocPhase phase);
+void alloc_tracker_report(FILE *file);
@@ -0,0 +1,44 @@
+#include "arena.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+void arena_init(Arena *arena, const char *name, size_t size)
+{
+    arena->name = name;
+    arena->base = new uint8_t[size];
+    arena->size = size;
+    arena->used = 0;
+    arena->peak = 0;
+}
+
+void arena_free(Arena *arena)
+{
+    delete[] arena->base;
+    arena->base = nullptr;
+    arena->size = 0;
+    arena->used = 0;
+}
+
+void arena_reset(Arena *arena)
+{
+    arena->used = 0;
+}
+
+void *arena_alloc(Arena *arena, size_t size, size_t align)
+{
+    uintptr_t address = (uintptr_t)(arena->base + arena->used);
+    size_t padding = (align - address % align) % align;
+    if (arena->used + padding + size > arena->size)
+    {
+        fprintf(stderr, "Arena %s out of memory: %zu of %zu bytes used, %zu requested\n",
+                arena->name, arena->used, arena->size, size);
+        abort();
+    }
+
+    void *p = arena->base + arena->used + padding;
+    arena->used += padding + size;
+    if (arena->used > arena->peak)
+        arena->peak = arena->used;
+    return p;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Linear allocator over one block reserved up front. Allocations are never
+// freed one by one, only all together by arena_reset or arena_free, so the
+// game loop can allocate without touching the heap.
+struct Arena
+{
+    const char *name;
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t peak;
+};
+
+void arena_init(Arena *arena, const char *name, size_t size);
+void arena_free(Arena *arena);
+void arena_reset(Arena *arena);
+
+// Memory is not initialized. Running out aborts: arena sizes are fixed
+// budgets, so exceeding one is a bug.
+void *arena_alloc(Arena *arena, size_t size, size_t align);
+
+template <typename T>
+T *arena_push(Arena *arena, size_t count)
+{
+    return (T *)arena_alloc(arena, count * sizeof(T), alignof(T));
+}
@@ -0,0 +1,258 @@
+#include "assets.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Sprites a pack may replace, with the shape the game relies on. A zero
+// width or height accepts any size.
+struct SpriteSlot
+{
+    const char *name;
+    Sprite *sprite;
+    size_t count;
+    size_t width, height;
+};
+
+static bool asset_fail(const char *path, const char *message, const char *name = "")
+{
+    fprintf(stderr, "Asset pack %s: %s%s%s\n", path, message, *name ? " " : "", name);
+    return false;
+}
+
+static bool asset_pack_parse(AssetPack *pack, const char *path)
+{
+    const uint8_t *base = (const uint8_t *)pack->map;
+    size_t size = pack->size;
+
+    const AssetPackHeader *header = (const AssetPackHeader *)base;
+    if (size < sizeof(AssetPackHeader) || header->magic != ASSET_PACK_MAGIC)
+        return asset_fail(path, "not an asset pack");
+    if (header->version != ASSET_PACK_VERSION)
+        return asset_fail(path, "unsupported version");
+    if (header->entries_offset % 8 ||
+        header->entries_offset + (size_t)header->num_entries * sizeof(AssetEntry) > size)
+    {
+        return asset_fail(path, "truncated entry table");
+    }
+
+    GameSprites &sprites = pack->sprites;
+    game_sprites_init(&sprites);
+    game_formation_init(&pack->formation);
+    game_palette_init(&pack->palette);
+
+    SpriteSlot slots[] = {
+        {"alien_a0", &sprites.alien_sprites[0], 1, 0, 0},
+        {"alien_a1", &sprites.alien_sprites[1], 1, 0, 0},
+        {"alien_b0", &sprites.alien_sprites[2], 1, 0, 0},
+        {"alien_b1", &sprites.alien_sprites[3], 1, 0, 0},
+        {"alien_c0", &sprites.alien_sprites[4], 1, 0, 0},
+        {"alien_c1", &sprites.alien_sprites[5], 1, 0, 0},
+        {"alien_death", &sprites.alien_death_sprite, 1, 0, 0},
+        {"player", &sprites.player_sprite, 1, 0, 0},
+        {"bullet", &sprites.bullet_sprite, 1, 0, 0},
+        {"text", &sprites.text_spritesheet, 65, 0, 0},
+        {"bunker", &sprites.bunker_sprite, 1, BUNKER_WIDTH, BUNKER_HEIGHT},
+        {"bunker_explosion", &sprites.bunker_explosion_sprite, 1, BUNKER_EXPLOSION_SIZE, BUNKER_EXPLOSION_SIZE}};
+
+    const AssetEntry *entries = (const AssetEntry *)(base + header->entries_offset);
+    for (size_t i = 0; i < header->num_entries; ++i)
+    {
+        const AssetEntry &entry = entries[i];
+        if (!memchr(entry.name, '\0', ASSET_NAME_SIZE))
+            return asset_fail(path, "unterminated entry name");
+        if (entry.offset % 8 || (size_t)entry.offset + entry.size > size)
+            return asset_fail(path, "entry out of bounds:", entry.name);
+
+        const uint8_t *data = base + entry.offset;
+        switch (entry.type)
+        {
+        case ASSET_SPRITE:
+        {
+            SpriteSlot *slot = nullptr;
+            for (SpriteSlot &candidate : slots)
+            {
+                if (strcmp(candidate.name, entry.name) == 0)
+                    slot = &candidate;
+            }
+            // Unknown sprites are skipped so newer packs still load
+            if (!slot)
+                break;
+
+            if (entry.count != slot->count || entry.width == 0 || entry.height == 0 ||
+                (size_t)entry.count * entry.width * entry.height != entry.size ||
+                (slot->width && entry.width != slot->width) ||
+                (slot->height && entry.height != slot->height))
+            {
+                return asset_fail(path, "bad sprite size:", entry.name);
+            }
+
+            slot->sprite->width = entry.width;
+            slot->sprite->height = entry.height;
+            slot->sprite->data = data;
+            break;
+        }
+
+        case ASSET_FORMATION:
+        {
+            if (entry.width == 0 || entry.height == 0 ||
+                (size_t)entry.width * entry.height > GAME_MAX_ALIENS ||
+                entry.size != sizeof(AssetFormation) + entry.height)
+            {
+                return asset_fail(path, "bad formation size:", entry.name);
+            }
+
+            const AssetFormation *formation = (const AssetFormation *)data;
+            const uint8_t *types = data + sizeof(AssetFormation);
+            for (size_t yi = 0; yi < entry.height; ++yi)
+            {
+                if (types[yi] < ALIEN_TYPE_A || types[yi] > ALIEN_TYPE_C)
+                    return asset_fail(path, "bad alien type in", entry.name);
+            }
+
+            pack->formation.rows = entry.height;
+            pack->formation.columns = entry.width;
+            pack->formation.spacing_x = formation->spacing_x;
+            pack->formation.spacing_y = formation->spacing_y;
+            pack->formation.x = formation->x;
+            pack->formation.y = formation->y;
+            pack->formation.types = types;
+            break;
+        }
+
+        case ASSET_PALETTE:
+            if (entry.count < PALETTE_NUM_COLORS || entry.size != entry.count * sizeof(uint32_t))
+                return asset_fail(path, "bad palette size:", entry.name);
+
+            pack->palette.colors = (const uint32_t *)data;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Both frames of an alien share a size, and the death sprite is centered
+    // over the widest of them
+    for (size_t i = 0; i < 6; i += 2)
+    {
+        const Sprite &frame_0 = sprites.alien_sprites[i];
+        const Sprite &frame_1 = sprites.alien_sprites[i + 1];
+        if (frame_0.width != frame_1.width || frame_0.height != frame_1.height)
+            return asset_fail(path, "alien animation frames differ in size:", slots[i].name);
+        if (frame_0.width > sprites.alien_death_sprite.width)
+            return asset_fail(path, "alien wider than alien_death:", slots[i].name);
+    }
+
+    sprites.number_spritesheet = sprites.text_spritesheet;
+    sprites.number_spritesheet.data += 16 * sprites.text_spritesheet.width * sprites.text_spritesheet.height;
+
+    sprite_bitplane_pack(sprites.bunker_sprite, sprites.bunker_rows);
+    sprite_bitplane_pack(sprites.bunker_explosion_sprite, sprites.bunker_explosion_rows);
+    return true;
+}
+
+bool asset_pack_load(AssetPack *pack, const char *path)
+{
+    pack->map = nullptr;
+    pack->size = 0;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return asset_fail(path, "cannot open");
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return asset_fail(path, "cannot read");
+    }
+
+    // Fault every page in now rather than in the middle of a frame
+    void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return asset_fail(path, "cannot map");
+
+    pack->map = map;
+    pack->size = st.st_size;
+    if (!asset_pack_parse(pack, path))
+    {
+        asset_pack_unload(pack);
+        return false;
+    }
+    return true;
+}
+
+void asset_pack_unload(AssetPack *pack)
+{
+    if (pack->map)
+        munmap(pack->map, pack->size);
+    pack->map = nullptr;
+    pack->size = 0;
+}
+
+bool asset_watch_init(AssetWatcher *watcher, const char *path)
+{
+    char dir[256];
+    const char *slash = strrchr(path, '/');
+    if (slash)
+    {
+        snprintf(dir, sizeof(dir), "%.*s", (int)(slash - path), path);
+        snprintf(watcher->name, sizeof(watcher->name), "%s", slash + 1);
+    }
+    else
+    {
+        snprintf(dir, sizeof(dir), ".");
+        snprintf(watcher->name, sizeof(watcher->name), "%s", path);
+    }
+    if (!dir[0])
+        snprintf(dir, sizeof(dir), "/");
+
+    watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher->fd < 0)
+        return false;
+
+    if (inotify_add_watch(watcher->fd, dir, IN_MOVED_TO) < 0)
+    {
+        close(watcher->fd);
+        watcher->fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void asset_watch_free(AssetWatcher *watcher)
+{
+    if (watcher->fd >= 0)
+        close(watcher->fd);
+    watcher->fd = -1;
+}
+
+bool asset_watch_changed(AssetWatcher *watcher)
+{
+    if (watcher->fd < 0)
+        return false;
+
+    bool changed = false;
+    alignas(inotify_event) char events[4096];
+    for (;;)
+    {
+        ssize_t len = read(watcher->fd, events, sizeof(events));
+        if (len <= 0)
+            break;
+
+        for (ssize_t i = 0; i < len;)
+        {
+            const inotify_event *event = (const inotify_event *)(events + i);
+            if (event->len && strcmp(event->name, watcher->name) == 0)
+                changed = true;
+            i += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
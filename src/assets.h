@@ -0,0 +1,89 @@
+#pragma once
+
+// Asset packs: sprites, glyph sheets, the alien formation and the palette in
+// one binary file, built from text sources by sic_pack. A pack is mapped
+// read-only and used in place; the Sprite, Formation and Palette structs it
+// fills point straight into the mapping.
+//
+// Layout (little endian, every offset from the start of the file and 8-byte
+// aligned):
+//   AssetPackHeader
+//   AssetEntry[num_entries]
+//   data
+//
+// Entry data by type:
+//   ASSET_SPRITE     count frames of width * height bytes, 1 for a set pixel
+//   ASSET_FORMATION  AssetFormation, then height (rows) bytes of AlienType
+//   ASSET_PALETTE    count uint32_t colors, indexed by PaletteColor
+
+#include <cstddef>
+#include <cstdint>
+
+#include "game.h"
+
+#define ASSET_PACK_MAGIC 0x50434953 // "SICP"
+#define ASSET_PACK_VERSION 1
+#define ASSET_NAME_SIZE 32
+
+struct AssetPackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_entries;
+    uint32_t entries_offset;
+};
+
+enum AssetType : uint32_t
+{
+    ASSET_SPRITE = 1,
+    ASSET_FORMATION = 2,
+    ASSET_PALETTE = 3
+};
+
+struct AssetEntry
+{
+    char name[ASSET_NAME_SIZE];
+    uint32_t type;
+    uint32_t width, height;
+    uint32_t count;
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct AssetFormation
+{
+    uint32_t spacing_x, spacing_y;
+    uint32_t x, y;
+};
+
+// Anything the pack does not contain keeps its built-in default.
+struct AssetPack
+{
+    void *map;
+    size_t size;
+
+    GameSprites sprites;
+    Formation formation;
+    Palette palette;
+};
+
+// Maps and validates a pack. On failure prints why to stderr and leaves the
+// pack unloaded.
+bool asset_pack_load(AssetPack *pack, const char *path);
+void asset_pack_unload(AssetPack *pack);
+
+// Watches the directory of a pack so replacing it (sic_pack writes a new file
+// and renames it over the old one) is noticed without blocking. Only renames
+// are reported: the game reads the mapped pack every frame, and a pack
+// rewritten in place is truncated under the mapping, so it may crash the game
+// before it could be reloaded.
+struct AssetWatcher
+{
+    int fd;
+    char name[256];
+};
+
+bool asset_watch_init(AssetWatcher *watcher, const char *path);
+void asset_watch_free(AssetWatcher *watcher);
+// True if the pack was replaced since the last call. Never blocks.
+bool asset_watch_changed(AssetWatcher *watcher);
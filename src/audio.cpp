@@ -0,0 +1,417 @@
+#include "audio.h"
+#include "arena.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <pthread.h>
+#include <thread>
+
+struct AudioSample
+{
+    const int16_t *data;
+    size_t length;
+};
+
+struct AudioVoice
+{
+    const int16_t *data;
+    size_t length;
+    size_t position;
+    int32_t gain;
+};
+
+struct AudioCommand
+{
+    AudioSound sound;
+    uint16_t gain;
+};
+
+struct Audio
+{
+    AudioSample samples[AUDIO_NUM_SOUNDS];
+
+    AudioVoice voices[AUDIO_MAX_VOICES];
+    int32_t mix[AUDIO_PERIOD_FRAMES];
+    int16_t out[AUDIO_PERIOD_FRAMES];
+
+    // Single producer (game thread), single consumer (mixer)
+    AudioCommand queue[AUDIO_QUEUE_SIZE];
+    std::atomic<size_t> queue_head;
+    std::atomic<size_t> queue_tail;
+    std::atomic<size_t> dropped_commands;
+
+    AudioBackend backend;
+    std::thread thread;
+    std::atomic<bool> running;
+};
+
+static_assert((AUDIO_QUEUE_SIZE & (AUDIO_QUEUE_SIZE - 1)) == 0, "AUDIO_QUEUE_SIZE must be a power of two");
+
+// Sample synthesis
+
+static size_t audio_duration(double seconds)
+{
+    return (size_t)(seconds * AUDIO_SAMPLE_RATE);
+}
+
+// Square wave sweeping from freq_start to freq_end with a linear fade out
+static void synth_sweep(int16_t *out, size_t length, double freq_start, double freq_end, double amplitude)
+{
+    double phase = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        double t = (double)i / length;
+        phase += (freq_start + (freq_end - freq_start) * t) / AUDIO_SAMPLE_RATE;
+        double square = phase - floor(phase) < 0.5 ? 1.0 : -1.0;
+        out[i] = (int16_t)(square * amplitude * (1.0 - t) * 32767);
+    }
+}
+
+// Low-passed white noise with an exponential decay
+static void synth_noise(int16_t *out, size_t length, double amplitude)
+{
+    uint32_t seed = 0x12345678;
+    double value = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        double noise = (double)(seed >> 16) / 32768.0 - 1.0;
+        value += 0.2 * (noise - value);
+        double envelope = exp(-5.0 * i / length);
+        out[i] = (int16_t)(value * amplitude * envelope * 32767);
+    }
+}
+
+// Returns the frames needed for all samples, each followed by a period of
+// silence so the mixer can always read a whole period from any position
+// inside it
+static size_t audio_sample_lengths(size_t lengths[AUDIO_NUM_SOUNDS])
+{
+    lengths[AUDIO_SOUND_FIRE] = audio_duration(0.12);
+    lengths[AUDIO_SOUND_EXPLOSION] = audio_duration(0.35);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        lengths[AUDIO_SOUND_MARCH_0 + i] = audio_duration(0.09);
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < AUDIO_NUM_SOUNDS; ++i)
+    {
+        total += lengths[i] + AUDIO_PERIOD_FRAMES;
+    }
+    return total;
+}
+
+static void audio_samples_init(Audio *audio, Arena *arena)
+{
+    static const double march_freqs[4] = {110.0, 98.0, 87.3, 82.4};
+
+    size_t lengths[AUDIO_NUM_SOUNDS];
+    size_t total = audio_sample_lengths(lengths);
+    int16_t *sample_memory = arena_push<int16_t>(arena, total);
+    memset(sample_memory, 0, total * sizeof(int16_t));
+
+    int16_t *data[AUDIO_NUM_SOUNDS];
+    data[0] = sample_memory;
+    for (size_t i = 1; i < AUDIO_NUM_SOUNDS; ++i)
+    {
+        data[i] = data[i - 1] + lengths[i - 1] + AUDIO_PERIOD_FRAMES;
+    }
+
+    synth_sweep(data[AUDIO_SOUND_FIRE], lengths[AUDIO_SOUND_FIRE], 1200.0, 300.0, 0.25);
+    synth_noise(data[AUDIO_SOUND_EXPLOSION], lengths[AUDIO_SOUND_EXPLOSION], 0.4);
+    for (size_t i = AUDIO_SOUND_MARCH_0; i <= AUDIO_SOUND_MARCH_3; ++i)
+    {
+        double freq = march_freqs[i - AUDIO_SOUND_MARCH_0];
+        synth_sweep(data[i], lengths[i], freq, freq, 0.3);
+    }
+
+    for (size_t i = 0; i < AUDIO_NUM_SOUNDS; ++i)
+    {
+        audio->samples[i].data = data[i];
+        audio->samples[i].length = lengths[i];
+    }
+}
+
+// Mixer
+
+static void audio_voice_start(Audio *audio, const AudioCommand &command)
+{
+    // Take a free voice, or steal the one closest to finishing
+    AudioVoice *voice = &audio->voices[0];
+    for (size_t i = 0; i < AUDIO_MAX_VOICES; ++i)
+    {
+        AudioVoice &candidate = audio->voices[i];
+        if (!candidate.data)
+        {
+            voice = &candidate;
+            break;
+        }
+        if (candidate.length - candidate.position < voice->length - voice->position)
+            voice = &candidate;
+    }
+
+    const AudioSample &sample = audio->samples[command.sound];
+    voice->data = sample.data;
+    voice->length = sample.length;
+    voice->position = 0;
+    voice->gain = command.gain;
+}
+
+void audio_mix(Audio *audio, int16_t *out, size_t num_frames)
+{
+    if (num_frames > AUDIO_PERIOD_FRAMES)
+        num_frames = AUDIO_PERIOD_FRAMES;
+
+    size_t head = audio->queue_head.load(std::memory_order_relaxed);
+    size_t tail = audio->queue_tail.load(std::memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+        audio_voice_start(audio, audio->queue[head & (AUDIO_QUEUE_SIZE - 1)]);
+    }
+    audio->queue_head.store(head, std::memory_order_release);
+
+    // Every loop below runs over a whole period, past num_frames and into the
+    // silence after each sample. A constant trip count lets GCC vectorize them
+    // at -O2, where its cost model rejects loops that need a scalar epilogue.
+    int32_t *__restrict mix = audio->mix;
+    for (size_t i = 0; i < AUDIO_PERIOD_FRAMES; ++i)
+    {
+        mix[i] = 0;
+    }
+
+    for (size_t vi = 0; vi < AUDIO_MAX_VOICES; ++vi)
+    {
+        AudioVoice &voice = audio->voices[vi];
+        if (!voice.data)
+            continue;
+
+        // Q15 fixed point
+        const int16_t *__restrict src = voice.data + voice.position;
+        const int32_t gain = voice.gain;
+        for (size_t i = 0; i < AUDIO_PERIOD_FRAMES; ++i)
+        {
+            mix[i] += (src[i] * gain) >> 15;
+        }
+
+        size_t n = voice.length - voice.position;
+        voice.position += n < num_frames ? n : num_frames;
+        if (voice.position == voice.length)
+            voice.data = nullptr;
+    }
+
+    int16_t *__restrict clamped = audio->out;
+    for (size_t i = 0; i < AUDIO_PERIOD_FRAMES; ++i)
+    {
+        int32_t s = mix[i];
+        s = s > 32767 ? 32767 : s;
+        s = s < -32768 ? -32768 : s;
+        clamped[i] = (int16_t)s;
+    }
+    if (out != audio->out)
+        memcpy(out, audio->out, num_frames * sizeof(int16_t));
+}
+
+void audio_render(Audio *audio, size_t num_frames)
+{
+    while (num_frames > 0)
+    {
+        size_t n = num_frames < AUDIO_PERIOD_FRAMES ? num_frames : AUDIO_PERIOD_FRAMES;
+        audio_mix(audio, audio->out, n);
+        audio->backend.write(audio->backend.user, audio->out, n);
+        num_frames -= n;
+    }
+}
+
+static void audio_thread(Audio *audio)
+{
+    // Best effort; needs CAP_SYS_NICE or an rtprio limit
+    sched_param param;
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+
+    using clock = std::chrono::steady_clock;
+    const clock::duration period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>((double)AUDIO_PERIOD_FRAMES / AUDIO_SAMPLE_RATE));
+
+    clock::time_point next = clock::now();
+    while (audio->running.load(std::memory_order_relaxed))
+    {
+        audio_render(audio, AUDIO_PERIOD_FRAMES);
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+Audio *audio_create(Arena *arena, AudioBackend backend)
+{
+    // Placement new: the atomics and the thread need constructing
+    Audio *audio = new (arena_push<Audio>(arena, 1)) Audio;
+    audio_samples_init(audio, arena);
+
+    for (size_t i = 0; i < AUDIO_MAX_VOICES; ++i)
+    {
+        audio->voices[i].data = nullptr;
+        audio->voices[i].length = 0;
+        audio->voices[i].position = 0;
+        audio->voices[i].gain = 0;
+    }
+
+    audio->queue_head.store(0);
+    audio->queue_tail.store(0);
+    audio->dropped_commands.store(0);
+
+    audio->backend = backend;
+    audio->running.store(false);
+    return audio;
+}
+
+void audio_destroy(Audio *audio)
+{
+    if (!audio)
+        return;
+
+    if (audio->running.load())
+    {
+        audio->running.store(false);
+        audio->thread.join();
+    }
+
+    audio->backend.close(audio->backend.user);
+    // The memory itself goes with the arena
+    audio->~Audio();
+}
+
+void audio_start(Audio *audio)
+{
+    if (audio->running.load())
+        return;
+
+    audio->running.store(true);
+    audio->thread = std::thread(audio_thread, audio);
+}
+
+bool audio_play(Audio *audio, AudioSound sound, uint16_t gain)
+{
+    size_t tail = audio->queue_tail.load(std::memory_order_relaxed);
+    size_t head = audio->queue_head.load(std::memory_order_acquire);
+    if (tail - head >= AUDIO_QUEUE_SIZE || sound >= AUDIO_NUM_SOUNDS)
+    {
+        audio->dropped_commands.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    AudioCommand &command = audio->queue[tail & (AUDIO_QUEUE_SIZE - 1)];
+    command.sound = sound;
+    command.gain = gain;
+    audio->queue_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+size_t audio_dropped_commands(const Audio *audio)
+{
+    return audio->dropped_commands.load(std::memory_order_relaxed);
+}
+
+// Backends
+
+static void null_write(void *, const int16_t *, size_t)
+{
+}
+
+static void null_close(void *)
+{
+}
+
+AudioBackend audio_null_backend()
+{
+    AudioBackend backend;
+    backend.user = nullptr;
+    backend.write = null_write;
+    backend.close = null_close;
+    return backend;
+}
+
+struct WavFile
+{
+    FILE *file;
+    size_t num_frames;
+    // Handed to setvbuf so stdio never allocates on the mixing thread
+    char buffer[64 * 1024];
+};
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xff;
+    p[1] = v >> 8;
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    put_u16(p, v & 0xffff);
+    put_u16(p + 2, v >> 16);
+}
+
+static void wav_header_write(FILE *file, size_t num_frames)
+{
+    uint32_t data_size = (uint32_t)(num_frames * sizeof(int16_t));
+    uint8_t header[44] = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+                          'f', 'm', 't', ' ', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                          'd', 'a', 't', 'a', 0, 0, 0, 0};
+    put_u32(header + 4, 36 + data_size);
+    put_u32(header + 16, 16);                                     // fmt chunk size
+    put_u16(header + 20, 1);                                      // PCM
+    put_u16(header + 22, 1);                                      // mono
+    put_u32(header + 24, AUDIO_SAMPLE_RATE);                      // sample rate
+    put_u32(header + 28, AUDIO_SAMPLE_RATE * sizeof(int16_t));    // byte rate
+    put_u16(header + 32, sizeof(int16_t));                        // block align
+    put_u16(header + 34, 16);                                     // bits per sample
+    put_u32(header + 40, data_size);
+    fwrite(header, sizeof(header), 1, file);
+}
+
+static void wav_write(void *user, const int16_t *frames, size_t num_frames)
+{
+    WavFile *wav = (WavFile *)user;
+    // NOTE: WAV is little endian, like every platform we build for
+    wav->num_frames += fwrite(frames, sizeof(int16_t), num_frames, wav->file);
+}
+
+static void wav_close(void *user)
+{
+    WavFile *wav = (WavFile *)user;
+    fflush(wav->file);
+    fseek(wav->file, 0, SEEK_SET);
+    wav_header_write(wav->file, wav->num_frames);
+    fclose(wav->file);
+}
+
+bool audio_wav_backend(AudioBackend *backend, Arena *arena, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    WavFile *wav = arena_push<WavFile>(arena, 1);
+    wav->file = file;
+    wav->num_frames = 0;
+    setvbuf(file, wav->buffer, _IOFBF, sizeof(wav->buffer));
+    wav_header_write(file, 0);
+
+    backend->user = wav;
+    backend->write = wav_write;
+    backend->close = wav_close;
+    return true;
+}
+
+size_t audio_arena_size()
+{
+    size_t lengths[AUDIO_NUM_SOUNDS];
+    return sizeof(Audio) + alignof(Audio) +
+           audio_sample_lengths(lengths) * sizeof(int16_t) + alignof(int16_t) +
+           sizeof(WavFile) + alignof(WavFile);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// Sound effects mixer. Samples are synthesized once at creation; afterwards the
+// game thread only pushes commands into a lock-free queue and the mixer, which
+// never locks or allocates, picks them up at the start of every period.
+
+#include <cstddef>
+#include <cstdint>
+
+struct Arena;
+
+#define AUDIO_SAMPLE_RATE 44100
+#define AUDIO_PERIOD_FRAMES 256
+#define AUDIO_MAX_VOICES 16
+#define AUDIO_QUEUE_SIZE 64
+#define AUDIO_GAIN_ONE 32768
+
+enum AudioSound : uint8_t
+{
+    AUDIO_SOUND_FIRE = 0,
+    AUDIO_SOUND_EXPLOSION = 1,
+    AUDIO_SOUND_MARCH_0 = 2,
+    AUDIO_SOUND_MARCH_1 = 3,
+    AUDIO_SOUND_MARCH_2 = 4,
+    AUDIO_SOUND_MARCH_3 = 5,
+    AUDIO_NUM_SOUNDS = 6
+};
+
+// Where mixed periods of mono 16-bit frames end up. write is called from the
+// mixing thread only; close is called once when the Audio is destroyed.
+struct AudioBackend
+{
+    void *user;
+    void (*write)(void *user, const int16_t *frames, size_t num_frames);
+    void (*close)(void *user);
+};
+
+// Discards everything; for running without a sound device.
+AudioBackend audio_null_backend();
+// Writes everything to a WAV file, finalized on close. Its state comes from the
+// arena.
+bool audio_wav_backend(AudioBackend *backend, Arena *arena, const char *path);
+
+struct Audio;
+
+// Bytes audio_create and audio_wav_backend take from their arena together,
+// including alignment padding.
+size_t audio_arena_size();
+// The mixer and its samples live as long as the arena; audio_destroy must run
+// before the arena is freed.
+Audio *audio_create(Arena *arena, AudioBackend backend);
+// Stops the mixing thread if running and closes the backend.
+void audio_destroy(Audio *audio);
+
+// Starts a real-time thread that mixes one period at a time, paced to the
+// sample rate. Without it, audio_render mixes offline as fast as possible.
+void audio_start(Audio *audio);
+void audio_render(Audio *audio, size_t num_frames);
+
+// Called from the game thread. gain is Q15 (AUDIO_GAIN_ONE is unity). Returns
+// false if the queue is full and the command was dropped.
+bool audio_play(Audio *audio, AudioSound sound, uint16_t gain);
+
+// The mixing callback: applies queued commands and mixes num_frames frames,
+// at most AUDIO_PERIOD_FRAMES, into out.
+void audio_mix(Audio *audio, int16_t *out, size_t num_frames);
+
+size_t audio_dropped_commands(const Audio *audio);
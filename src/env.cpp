@@ -0,0 +1,369 @@
+#include "env.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+
+#define ENV_WIDTH 224
+#define ENV_HEIGHT 256
+// int16_t values in a feature observation
+#define ENV_NUM_FEATURES (3 + 3 * GAME_MAX_ALIENS + 2 * GAME_MAX_BULLET)
+// Envs handed to a worker at a time; large enough to amortize the atomic.
+#define ENV_CHUNK_SIZE 32
+
+enum EnvJob
+{
+    ENV_JOB_RESET,
+    ENV_JOB_STEP
+};
+
+struct SicEnv
+{
+    size_t num_envs;
+    int obs_mode;
+    size_t obs_size;
+    size_t max_steps;
+
+    GameSprites sprites;
+    Formation formation;
+    Arena arena;
+    Game *games;
+    size_t *steps;
+    uint64_t *seeds;
+
+    // Arguments of the job being run
+    EnvJob job;
+    const uint64_t *job_seeds;
+    const uint8_t *actions;
+    uint8_t *obs;
+    float *reward;
+    uint8_t *done;
+
+    // Thread pool
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    size_t generation;
+    bool quit;
+    size_t num_chunks;
+    std::atomic<size_t> next_chunk;
+    std::atomic<size_t> chunks_done;
+};
+
+static void obs_sprite_draw(uint8_t *obs, size_t width, size_t height,
+                            const Sprite &sprite, size_t x, size_t y)
+{
+    size_t row_bytes = width / 8;
+    for (size_t yi = 0; yi < sprite.height; ++yi)
+    {
+        // Same placement as buffer_sprite_draw, flipped so row 0 is the top
+        size_t by = sprite.height - 1 + y - yi;
+        if (by >= height)
+            continue;
+
+        uint8_t *row = obs + (height - 1 - by) * row_bytes;
+        const uint8_t *data = sprite.data + yi * sprite.width;
+        for (size_t xi = 0; xi < sprite.width && x + xi < width; ++xi)
+        {
+            if (data[xi])
+                row[(x + xi) >> 3] |= 0x80 >> ((x + xi) & 7);
+        }
+    }
+}
+
+static void obs_bunker_draw(uint8_t *obs, size_t width, size_t height, const Bunker &bunker)
+{
+    size_t row_bytes = width / 8;
+    for (size_t r = 0; r < BUNKER_HEIGHT; ++r)
+    {
+        size_t by = bunker.y + BUNKER_HEIGHT - 1 - r;
+        if (by >= height)
+            continue;
+
+        uint8_t *row = obs + (height - 1 - by) * row_bytes;
+        uint64_t bits = bunker.rows[r];
+        while (bits)
+        {
+            size_t x = bunker.x + __builtin_ctzll(bits);
+            if (x < width)
+                row[x >> 3] |= 0x80 >> (x & 7);
+            bits &= bits - 1;
+        }
+    }
+}
+
+static void env_observe_pixels(SicEnv *env, size_t i, uint8_t *obs)
+{
+    const Game &game = env->games[i];
+    const GameSprites &sprites = env->sprites;
+    memset(obs, 0, env->obs_size);
+
+    // Alien animations have two frames of 10 ticks each
+    size_t current_frame = (env->steps[i] / 10) & 1;
+    for (size_t ai = 0; ai < game.num_aliens; ++ai)
+    {
+        if (!game.death_counters[ai])
+            continue;
+
+        const Alien &alien = game.aliens[ai];
+        const Sprite &sprite = alien.type == ALIEN_DEAD
+                                   ? sprites.alien_death_sprite
+                                   : sprites.alien_sprites[2 * (alien.type - 1) + current_frame];
+        obs_sprite_draw(obs, game.width, game.height, sprite, alien.x, alien.y);
+    }
+
+    for (size_t bki = 0; bki < GAME_NUM_BUNKERS; ++bki)
+    {
+        obs_bunker_draw(obs, game.width, game.height, game.bunkers[bki]);
+    }
+
+    for (size_t bi = 0; bi < game.num_bullets; ++bi)
+    {
+        const Bullet &bullet = game.bullets[bi];
+        obs_sprite_draw(obs, game.width, game.height, sprites.bullet_sprite, bullet.x, bullet.y);
+    }
+
+    obs_sprite_draw(obs, game.width, game.height, sprites.player_sprite, game.player.x, game.player.y);
+}
+
+static void env_observe_features(SicEnv *env, size_t i, uint8_t *obs)
+{
+    const Game &game = env->games[i];
+    // Built locally and copied out, since obs need not be 2-byte aligned
+    int16_t buffer[ENV_NUM_FEATURES] = {};
+    int16_t *features = buffer;
+
+    *features++ = (int16_t)game.player.x;
+    *features++ = (int16_t)game.player.y;
+    *features++ = (int16_t)game.num_bullets;
+
+    for (size_t ai = 0; ai < game.num_aliens; ++ai)
+    {
+        const Alien &alien = game.aliens[ai];
+        *features++ = alien.type;
+        *features++ = (int16_t)alien.x;
+        *features++ = (int16_t)alien.y;
+    }
+
+    features += 3 * (GAME_MAX_ALIENS - game.num_aliens);
+    for (size_t bi = 0; bi < game.num_bullets; ++bi)
+    {
+        features[2 * bi] = (int16_t)game.bullets[bi].x;
+        features[2 * bi + 1] = (int16_t)game.bullets[bi].y;
+    }
+
+    memcpy(obs, buffer, sizeof(buffer));
+}
+
+static void env_observe(SicEnv *env, size_t i)
+{
+    uint8_t *obs = env->obs + i * env->obs_size;
+    if (env->obs_mode == SIC_OBS_PIXELS)
+        env_observe_pixels(env, i, obs);
+    else
+        env_observe_features(env, i, obs);
+}
+
+static void env_reset_one(SicEnv *env, size_t i)
+{
+    if (env->job_seeds)
+        env->seeds[i] = env->job_seeds[i];
+    game_reset(&env->games[i], env->sprites, env->formation);
+    env->steps[i] = 0;
+    env_observe(env, i);
+}
+
+static void env_step_one(SicEnv *env, size_t i)
+{
+    Game &game = env->games[i];
+    uint8_t action = env->actions[i];
+
+    int move_dir = 0;
+    if (action == SIC_ACTION_LEFT || action == SIC_ACTION_LEFT_FIRE)
+        move_dir = -1;
+    else if (action == SIC_ACTION_RIGHT || action == SIC_ACTION_RIGHT_FIRE)
+        move_dir = 1;
+    bool fire_pressed = action >= SIC_ACTION_FIRE && action < SIC_NUM_ACTIONS;
+
+    size_t gained = game_update(&game, env->sprites, move_dir, fire_pressed);
+    ++env->steps[i];
+
+    bool done = game_cleared(game) || (env->max_steps && env->steps[i] >= env->max_steps);
+    env->reward[i] = (float)gained;
+    env->done[i] = done;
+
+    if (done)
+    {
+        game_reset(&game, env->sprites, env->formation);
+        env->steps[i] = 0;
+    }
+    env_observe(env, i);
+}
+
+static void env_run_chunks(SicEnv *env)
+{
+    for (;;)
+    {
+        size_t chunk = env->next_chunk.fetch_add(1);
+        if (chunk >= env->num_chunks)
+            break;
+
+        size_t begin = chunk * ENV_CHUNK_SIZE;
+        size_t end = begin + ENV_CHUNK_SIZE < env->num_envs ? begin + ENV_CHUNK_SIZE : env->num_envs;
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (env->job == ENV_JOB_STEP)
+                env_step_one(env, i);
+            else
+                env_reset_one(env, i);
+        }
+        env->chunks_done.fetch_add(1);
+    }
+}
+
+static void env_worker(SicEnv *env)
+{
+    size_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(env->mutex);
+            env->wake.wait(lock, [&]
+                           { return env->quit || env->generation != seen; });
+            if (env->quit)
+                return;
+            seen = env->generation;
+        }
+        env_run_chunks(env);
+    }
+}
+
+// Runs the current job over all envs. The calling thread works alongside the
+// pool and returns once every chunk is finished.
+static void env_dispatch(SicEnv *env)
+{
+    env->chunks_done.store(0);
+    env->next_chunk.store(0);
+    if (!env->workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(env->mutex);
+            ++env->generation;
+        }
+        env->wake.notify_all();
+    }
+
+    env_run_chunks(env);
+    while (env->chunks_done.load() < env->num_chunks)
+    {
+        std::this_thread::yield();
+    }
+}
+
+SicEnv *sic_env_create(size_t num_envs, size_t num_threads, int obs_mode, size_t max_steps)
+{
+    if (num_envs == 0 || (obs_mode != SIC_OBS_PIXELS && obs_mode != SIC_OBS_FEATURES))
+        return nullptr;
+
+    SicEnv *env = new SicEnv;
+    env->num_envs = num_envs;
+    env->obs_mode = obs_mode;
+    env->obs_size = obs_mode == SIC_OBS_PIXELS
+                        ? ENV_WIDTH / 8 * ENV_HEIGHT
+                        : ENV_NUM_FEATURES * sizeof(int16_t);
+    env->max_steps = max_steps;
+
+    game_sprites_init(&env->sprites);
+    game_formation_init(&env->formation);
+    size_t env_size = sizeof(Game) + alignof(Game) + game_arena_size() +
+                      sizeof(size_t) + alignof(size_t) + sizeof(uint64_t) + alignof(uint64_t);
+    arena_init(&env->arena, "env", num_envs * env_size);
+    env->games = arena_push<Game>(&env->arena, num_envs);
+    env->steps = arena_push<size_t>(&env->arena, num_envs);
+    env->seeds = arena_push<uint64_t>(&env->arena, num_envs);
+    for (size_t i = 0; i < num_envs; ++i)
+    {
+        game_init(&env->games[i], &env->arena, ENV_WIDTH, ENV_HEIGHT);
+        game_reset(&env->games[i], env->sprites, env->formation);
+        env->steps[i] = 0;
+        env->seeds[i] = 0;
+    }
+
+    env->job = ENV_JOB_RESET;
+    env->job_seeds = nullptr;
+    env->actions = nullptr;
+    env->obs = nullptr;
+    env->reward = nullptr;
+    env->done = nullptr;
+
+    env->generation = 0;
+    env->quit = false;
+    env->num_chunks = (num_envs + ENV_CHUNK_SIZE - 1) / ENV_CHUNK_SIZE;
+    env->next_chunk.store(env->num_chunks);
+    env->chunks_done.store(env->num_chunks);
+
+    if (num_threads == 0)
+        num_threads = std::thread::hardware_concurrency();
+    if (num_threads > env->num_chunks)
+        num_threads = env->num_chunks;
+    // The calling thread is one of the workers
+    for (size_t t = 1; t < num_threads; ++t)
+    {
+        env->workers.emplace_back(env_worker, env);
+    }
+
+    return env;
+}
+
+void sic_env_destroy(SicEnv *env)
+{
+    if (!env)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(env->mutex);
+        env->quit = true;
+    }
+    env->wake.notify_all();
+    for (std::thread &worker : env->workers)
+    {
+        worker.join();
+    }
+
+    arena_free(&env->arena);
+    delete env;
+}
+
+size_t sic_env_num_envs(const SicEnv *env)
+{
+    return env->num_envs;
+}
+
+size_t sic_env_obs_size(const SicEnv *env)
+{
+    return env->obs_size;
+}
+
+void sic_env_reset(SicEnv *env, const uint64_t *seeds, uint8_t *obs)
+{
+    env->job = ENV_JOB_RESET;
+    env->job_seeds = seeds;
+    env->obs = obs;
+    env_dispatch(env);
+}
+
+void sic_env_step(SicEnv *env, const uint8_t *actions,
+                  uint8_t *obs, float *reward, uint8_t *done)
+{
+    env->job = ENV_JOB_STEP;
+    env->actions = actions;
+    env->obs = obs;
+    env->reward = reward;
+    env->done = done;
+    env_dispatch(env);
+}
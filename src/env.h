@@ -0,0 +1,62 @@
+#pragma once
+
+// Batched environment API for training agents against the game without a
+// window. N independent games are stepped in lockstep on a thread pool; all
+// output arrays are owned by the caller and written in place.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct SicEnv SicEnv;
+
+    enum SicObsMode
+    {
+        // Screen packed at one bit per pixel (most significant bit first) with
+        // width / 8 bytes per row and row 0 at the top of the screen.
+        SIC_OBS_PIXELS = 0,
+        // int16_t entity features in native byte order, with no alignment
+        // required of obs:
+        //   player x, player y, number of bullets,
+        //   GAME_MAX_ALIENS x (type, x, y)  (type 0 once hit or past the formation),
+        //   GAME_MAX_BULLET x (x, y)        (zero past the number of bullets).
+        SIC_OBS_FEATURES = 1
+    };
+
+    enum SicAction
+    {
+        SIC_ACTION_NOOP = 0,
+        SIC_ACTION_LEFT = 1,
+        SIC_ACTION_RIGHT = 2,
+        SIC_ACTION_FIRE = 3,
+        SIC_ACTION_LEFT_FIRE = 4,
+        SIC_ACTION_RIGHT_FIRE = 5,
+        SIC_NUM_ACTIONS = 6
+    };
+
+    // num_threads == 0 uses one thread per hardware core. Episodes end once the
+    // wave is cleared or after max_steps ticks (0 means no limit).
+    SicEnv *sic_env_create(size_t num_envs, size_t num_threads, int obs_mode, size_t max_steps);
+    void sic_env_destroy(SicEnv *env);
+
+    size_t sic_env_num_envs(const SicEnv *env);
+    // Bytes of observation written per environment.
+    size_t sic_env_obs_size(const SicEnv *env);
+
+    // Restarts every game and writes the first observations. The simulation has
+    // no randomness yet, so seeds (one per env, may be NULL) are only recorded.
+    void sic_env_reset(SicEnv *env, const uint64_t *seeds, uint8_t *obs);
+
+    // Applies one SicAction per env and advances every game by one tick. The
+    // reward is the score gained in that tick. Finished games are reset
+    // immediately, so obs for a done env is the first frame of its next episode.
+    void sic_env_step(SicEnv *env, const uint8_t *actions,
+                      uint8_t *obs, float *reward, uint8_t *done);
+
+#ifdef __cplusplus
+}
+#endif
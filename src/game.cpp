@@ -0,0 +1,621 @@
+#include "game.h"
+
+static const uint8_t alien_a0_data[64] = {
+    0, 0, 0, 1, 1, 0, 0, 0, // ...@@...
+    0, 0, 1, 1, 1, 1, 0, 0, // ..@@@@..
+    0, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@.
+    1, 1, 0, 1, 1, 0, 1, 1, // @@.@@.@@
+    1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@
+    0, 1, 0, 1, 1, 0, 1, 0, // .@.@@.@.
+    1, 0, 0, 0, 0, 0, 0, 1, // @......@
+    0, 1, 0, 0, 0, 0, 1, 0  // .@....@.
+};
+
+static const uint8_t alien_a1_data[64] = {
+    0, 0, 0, 1, 1, 0, 0, 0, // ...@@...
+    0, 0, 1, 1, 1, 1, 0, 0, // ..@@@@..
+    0, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@.
+    1, 1, 0, 1, 1, 0, 1, 1, // @@.@@.@@
+    1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@
+    0, 0, 1, 0, 0, 1, 0, 0, // ..@..@..
+    0, 1, 0, 1, 1, 0, 1, 0, // .@.@@.@.
+    1, 0, 1, 0, 0, 1, 0, 1  // @.@..@.@
+};
+
+static const uint8_t alien_b0_data[88] = {
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, // ..@.....@..
+    0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, // ...@...@...
+    0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, // ..@@@@@@@..
+    0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, // .@@.@@@.@@.
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
+    1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 1, // @.@@@@@@@.@
+    1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, // @.@.....@.@
+    0, 0, 0, 1, 1, 0, 1, 1, 0, 0, 0  // ...@@.@@...
+};
+
+static const uint8_t alien_b1_data[88] = {
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, // ..@.....@..
+    1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, // @..@...@..@
+    1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 1, // @.@@@@@@@.@
+    1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, // @@@.@@@.@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@.
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, // ..@.....@..
+    0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0  // .@.......@.
+};
+
+static const uint8_t alien_c0_data[96] = {
+    0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, // ....@@@@....
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@@.
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
+    1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, // @@@..@@..@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
+    0, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, // ...@@..@@...
+    0, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, // ..@@.@@.@@..
+    1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1  // @@........@@
+};
+
+static const uint8_t alien_c1_data[96] = {
+    0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, // ....@@@@....
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@@.
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
+    1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, // @@@..@@..@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
+    0, 0, 1, 1, 1, 0, 0, 1, 1, 1, 0, 0, // ..@@@..@@@..
+    0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, // .@@..@@..@@.
+    0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0  // ..@@....@@..
+};
+
+static const uint8_t alien_death_data[91] = {
+    0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, // .@..@...@..@.
+    0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, // ..@..@.@..@..
+    0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, // ...@.....@...
+    1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, // @@.........@@
+    0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, // ...@.....@...
+    0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, // ..@..@.@..@..
+    0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0  // .@..@...@..@.
+};
+
+static const uint8_t player_data[77] = {
+    0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, // .....@.....
+    0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, // ....@@@....
+    0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, // ....@@@....
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@.
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
+};
+
+static const uint8_t bullet_data[3] = {
+    1, // @
+    1, // @
+    1  // @
+};
+
+static const uint8_t text_spritesheet_data[65 * 35] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+    0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 0,
+    1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1,
+    0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1,
+    0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+    1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0,
+    0, 0, 1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+    0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
+
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+
+    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
+    0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
+    1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
+    0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0,
+    0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1,
+    1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+    1, 0, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1,
+    1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1,
+    0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 0, 0, 1,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
+    1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+
+    0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1,
+    0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+    1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+
+static const uint8_t bunker_data[352] = {
+    0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, // ....@@@@@@@@@@@@@@....
+    0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, // ...@@@@@@@@@@@@@@@@...
+    0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, // ..@@@@@@@@@@@@@@@@@@..
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@@@@@@@@@@@@.
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@@@@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@......@@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@........@@@@@@@
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, // @@@@@@..........@@@@@@
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1  // @@@@@@..........@@@@@@
+};
+
+static const uint8_t bunker_explosion_data[64] = {
+    1, 0, 0, 0, 1, 0, 0, 1, // @...@..@
+    0, 0, 1, 0, 0, 0, 1, 0, // ..@...@.
+    0, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@.
+    1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@
+    1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@
+    0, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@.
+    0, 0, 1, 0, 0, 1, 0, 0, // ..@..@..
+    1, 0, 0, 0, 1, 0, 0, 1  // @...@..@
+};
+
+void game_sprites_init(GameSprites *sprites)
+{
+    static const uint8_t *alien_data[6] = {
+        alien_a0_data, alien_a1_data,
+        alien_b0_data, alien_b1_data,
+        alien_c0_data, alien_c1_data};
+    static const size_t alien_widths[3] = {8, 11, 12};
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        sprites->alien_sprites[i].width = alien_widths[i / 2];
+        sprites->alien_sprites[i].height = 8;
+        sprites->alien_sprites[i].data = alien_data[i];
+    }
+
+    sprites->alien_death_sprite.width = 13;
+    sprites->alien_death_sprite.height = 7;
+    sprites->alien_death_sprite.data = alien_death_data;
+
+    sprites->player_sprite.width = 11;
+    sprites->player_sprite.height = 7;
+    sprites->player_sprite.data = player_data;
+
+    sprites->bullet_sprite.width = 1;
+    sprites->bullet_sprite.height = 3;
+    sprites->bullet_sprite.data = bullet_data;
+
+    sprites->text_spritesheet.width = 5;
+    sprites->text_spritesheet.height = 7;
+    sprites->text_spritesheet.data = text_spritesheet_data;
+
+    sprites->number_spritesheet = sprites->text_spritesheet;
+    sprites->number_spritesheet.data += 16 * 35;
+
+    sprites->bunker_sprite.width = BUNKER_WIDTH;
+    sprites->bunker_sprite.height = BUNKER_HEIGHT;
+    sprites->bunker_sprite.data = bunker_data;
+
+    sprites->bunker_explosion_sprite.width = BUNKER_EXPLOSION_SIZE;
+    sprites->bunker_explosion_sprite.height = BUNKER_EXPLOSION_SIZE;
+    sprites->bunker_explosion_sprite.data = bunker_explosion_data;
+
+    sprite_bitplane_pack(sprites->bunker_sprite, sprites->bunker_rows);
+    sprite_bitplane_pack(sprites->bunker_explosion_sprite, sprites->bunker_explosion_rows);
+}
+
+void game_formation_init(Formation *formation)
+{
+    static const uint8_t types[5] = {ALIEN_TYPE_C, ALIEN_TYPE_C, ALIEN_TYPE_B, ALIEN_TYPE_B, ALIEN_TYPE_A};
+
+    formation->rows = 5;
+    formation->columns = 11;
+    formation->spacing_x = 16;
+    formation->spacing_y = 17;
+    formation->x = 20;
+    formation->y = 128;
+    formation->types = types;
+}
+
+void game_palette_init(Palette *palette)
+{
+    // 0x800000ff is rgb_to_uint32(128, 0, 0)
+    static const uint32_t colors[PALETTE_NUM_COLORS] = {
+        0x008000ff, // background
+        0x800000ff, // text
+        0x800000ff, // ground
+        0x800000ff, // alien
+        0x800000ff, // player
+        0x800000ff, // bullet
+        0x800000ff  // bunker
+    };
+
+    palette->colors = colors;
+}
+
+void sprite_bitplane_pack(const Sprite &sprite, uint64_t *rows)
+{
+    for (size_t yi = 0; yi < sprite.height; ++yi)
+    {
+        uint64_t row = 0;
+        for (size_t xi = 0; xi < sprite.width && xi < 64; ++xi)
+        {
+            if (sprite.data[yi * sprite.width + xi])
+                row |= (uint64_t)1 << xi;
+        }
+        rows[yi] = row;
+    }
+}
+
+size_t game_arena_size()
+{
+    return GAME_MAX_ALIENS * sizeof(Alien) + alignof(Alien) +
+           GAME_MAX_ALIENS * sizeof(uint8_t);
+}
+
+void game_init(Game *game, Arena *arena, size_t width, size_t height)
+{
+    game->width = width;
+    game->height = height;
+    game->num_aliens = 0;
+    game->num_bullets = 0;
+    game->score = 0;
+    game->events = 0;
+    game->dropped_bullets = 0;
+    game->aliens = arena_push<Alien>(arena, GAME_MAX_ALIENS);
+    game->death_counters = arena_push<uint8_t>(arena, GAME_MAX_ALIENS);
+}
+
+void game_reset(Game *game, const GameSprites &sprites, const Formation &formation)
+{
+    game->num_bullets = 0;
+    game->score = 0;
+    game->events = 0;
+
+    game->player.x = 122 - 5;
+    game->player.y = 32;
+
+    game->player.life = 3;
+
+    game->num_aliens = formation.rows * formation.columns;
+    for (size_t yi = 0; yi < formation.rows; ++yi)
+    {
+        for (size_t xi = 0; xi < formation.columns; ++xi)
+        {
+            Alien &alien = game->aliens[yi * formation.columns + xi];
+            alien.type = formation.types[yi];
+
+            const Sprite &sprite = sprites.alien_sprites[2 * (alien.type - 1)];
+
+            alien.x = formation.spacing_x * xi + formation.x + (sprites.alien_death_sprite.width - sprite.width) / 2;
+            alien.y = formation.spacing_y * yi + formation.y;
+        }
+    }
+
+    for (size_t i = 0; i < game->num_aliens; ++i)
+    {
+        game->death_counters[i] = 10;
+    }
+
+    game_bunkers_reset(game, sprites);
+}
+
+void game_bunkers_reset(Game *game, const GameSprites &sprites)
+{
+    for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i)
+    {
+        Bunker &bunker = game->bunkers[i];
+        // Centered in four equal columns of the screen
+        bunker.x = game->width * (2 * i + 1) / (2 * GAME_NUM_BUNKERS) - BUNKER_WIDTH / 2;
+        bunker.y = 48;
+        for (size_t r = 0; r < BUNKER_HEIGHT; ++r)
+        {
+            bunker.rows[r] = sprites.bunker_rows[r];
+        }
+    }
+}
+
+// Clears the explosion mask centered on pixel (column, row) of the bunker.
+static void bunker_erode(Bunker *bunker, const uint64_t *explosion_rows, size_t column, size_t row)
+{
+    const int half = BUNKER_EXPLOSION_SIZE / 2;
+    int shift = (int)column - half;
+    for (int ei = 0; ei < BUNKER_EXPLOSION_SIZE; ++ei)
+    {
+        int r = (int)row + ei - half;
+        if (r < 0 || r >= BUNKER_HEIGHT)
+            continue;
+
+        uint64_t mask = shift >= 0 ? explosion_rows[ei] << shift : explosion_rows[ei] >> -shift;
+        bunker->rows[r] &= ~mask;
+    }
+}
+
+// Tests the rows covered by a bullet against its column of the bunker, in the
+// order the bullet travels through them, and erodes the bunker at the first hit.
+static bool bunker_bullet_hit(Bunker *bunker, const GameSprites &sprites, const Bullet &bullet)
+{
+    size_t bullet_height = sprites.bullet_sprite.height;
+    if (bullet.x < bunker->x || bullet.x >= bunker->x + BUNKER_WIDTH ||
+        bullet.y >= bunker->y + BUNKER_HEIGHT || bullet.y + bullet_height <= bunker->y)
+    {
+        return false;
+    }
+
+    size_t column = bullet.x - bunker->x;
+    uint64_t column_bit = (uint64_t)1 << column;
+    for (size_t i = 0; i < bullet_height; ++i)
+    {
+        size_t y = bullet.dir > 0 ? bullet.y + i : bullet.y + bullet_height - 1 - i;
+        if (y < bunker->y || y >= bunker->y + BUNKER_HEIGHT)
+            continue;
+
+        size_t row = bunker->y + BUNKER_HEIGHT - 1 - y;
+        if (bunker->rows[row] & column_bit)
+        {
+            bunker_erode(bunker, sprites.bunker_explosion_rows, column, row);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t game_update(Game *game, const GameSprites &sprites, int move_dir, bool fire_pressed)
+{
+    const Sprite &bullet_sprite = sprites.bullet_sprite;
+    const Sprite &player_sprite = sprites.player_sprite;
+    size_t score_before = game->score;
+    game->events = 0;
+
+    // Simulate aliens
+    for (size_t ai = 0; ai < game->num_aliens; ++ai)
+    {
+        const Alien &alien = game->aliens[ai];
+        if (alien.type == ALIEN_DEAD && game->death_counters[ai])
+        {
+            --game->death_counters[ai];
+        }
+    }
+
+    // Simulate bullets
+    for (size_t bi = 0; bi < game->num_bullets;)
+    {
+        game->bullets[bi].y += game->bullets[bi].dir;
+        if (game->bullets[bi].y >= game->height || game->bullets[bi].y < bullet_sprite.height)
+        {
+            game->bullets[bi] = game->bullets[game->num_bullets - 1];
+            --game->num_bullets;
+            continue;
+        }
+
+        bool bunker_hit = false;
+        for (size_t i = 0; i < GAME_NUM_BUNKERS && !bunker_hit; ++i)
+        {
+            bunker_hit = bunker_bullet_hit(&game->bunkers[i], sprites, game->bullets[bi]);
+        }
+        if (bunker_hit)
+        {
+            game->events |= GAME_EVENT_BUNKER_HIT;
+            game->bullets[bi] = game->bullets[game->num_bullets - 1];
+            --game->num_bullets;
+            continue;
+        }
+
+        // Check hit
+        bool alien_hit = false;
+        for (size_t ai = 0; ai < game->num_aliens; ++ai)
+        {
+            const Alien &alien = game->aliens[ai];
+            if (alien.type == ALIEN_DEAD)
+                continue;
+
+            // NOTE: Both animation frames of an alien type share the same size,
+            // so the first frame is enough for the overlap test.
+            const Sprite &alien_sprite = sprites.alien_sprites[2 * (alien.type - 1)];
+            bool overlap = sprite_overlap_check(
+                bullet_sprite, game->bullets[bi].x, game->bullets[bi].y,
+                alien_sprite, alien.x, alien.y);
+            if (overlap)
+            {
+                game->score += 10 * (4 - game->aliens[ai].type);
+                game->events |= GAME_EVENT_ALIEN_HIT;
+                game->aliens[ai].type = ALIEN_DEAD;
+                // NOTE: Hack to recenter death sprite
+                game->aliens[ai].x -= (sprites.alien_death_sprite.width - alien_sprite.width) / 2;
+                game->bullets[bi] = game->bullets[game->num_bullets - 1];
+                --game->num_bullets;
+                alien_hit = true;
+                break;
+            }
+        }
+        if (alien_hit)
+            continue;
+
+        ++bi;
+    }
+
+    // Simulate player
+    int player_move_dir = 2 * move_dir;
+
+    if (player_move_dir != 0)
+    {
+        if (game->player.x + player_sprite.width + player_move_dir >= game->width)
+        {
+            game->player.x = game->width - player_sprite.width;
+        }
+        else if ((int)game->player.x + player_move_dir <= 0)
+        {
+            game->player.x = 0;
+        }
+        else
+            game->player.x += player_move_dir;
+    }
+
+    // Process events
+    if (fire_pressed && game->num_bullets < GAME_MAX_BULLET)
+    {
+        game->bullets[game->num_bullets].x = game->player.x + player_sprite.width / 2;
+        game->bullets[game->num_bullets].y = game->player.y + player_sprite.height;
+        game->bullets[game->num_bullets].dir = 2;
+        ++game->num_bullets;
+        game->events |= GAME_EVENT_FIRE;
+    }
+    else if (fire_pressed)
+    {
+        ++game->dropped_bullets;
+    }
+
+    return game->score - score_before;
+}
+
+bool game_cleared(const Game &game)
+{
+    for (size_t ai = 0; ai < game.num_aliens; ++ai)
+    {
+        if (game.aliens[ai].type != ALIEN_DEAD || game.death_counters[ai])
+            return false;
+    }
+    return true;
+}
+
+void buffer_sprite_draw(Buffer *buffer, const Sprite &sprite, size_t x, size_t y, uint32_t color)
+{
+    for (size_t xi = 0; xi < sprite.width; ++xi)
+    {
+        for (size_t yi = 0; yi < sprite.height; ++yi)
+        {
+            if (sprite.data[yi * sprite.width + xi] &&
+                (sprite.height - 1 + y - yi) < buffer->height &&
+                (x + xi) < buffer->width)
+            {
+                buffer->data[(sprite.height - 1 + y - yi) * buffer->width + (x + xi)] = color;
+            }
+        }
+    }
+}
+
+void buffer_bunker_draw(Buffer *buffer, const Bunker &bunker, uint32_t color)
+{
+    for (size_t r = 0; r < BUNKER_HEIGHT; ++r)
+    {
+        size_t y = bunker.y + BUNKER_HEIGHT - 1 - r;
+        if (y >= buffer->height)
+            continue;
+
+        uint32_t *line = buffer->data + y * buffer->width;
+        uint64_t bits = bunker.rows[r];
+        while (bits)
+        {
+            size_t x = bunker.x + __builtin_ctzll(bits);
+            if (x < buffer->width)
+                line[x] = color;
+            bits &= bits - 1;
+        }
+    }
+}
+
+bool sprite_overlap_check(const Sprite &sp_a, size_t x_a, size_t y_a,
+                          const Sprite &sp_b, size_t x_b, size_t y_b)
+{
+    // NOTE: For simplicity we just check for overlap of the sprite rectangles.
+    if (x_a < x_b + sp_b.width && x_a + sp_a.width > x_b &&
+        y_a < y_b + sp_b.height && y_a + sp_a.width > y_b)
+    {
+        return true;
+    }
+    return false;
+}
+
+uint32_t rgb_to_uint32(uint8_t r, uint8_t g, uint8_t b)
+{
+    return (r << 24) | (g << 16) | (b << 8) | 255;
+    // sets the left-most 24 bits to the r, g, and b values respectively
+    // and last 8 bits to 255 for alpha
+}
+
+void buffer_clear(Buffer *b, uint32_t col)
+{
+    for (size_t i = 0; i < b->width * b->height; ++i)
+    {
+        b->data[i] = col;
+    }
+}
+
+void buffer_text_draw(Buffer *buffer, const Sprite &text_spritesheet, const char *text,
+                      size_t x, size_t y, uint32_t color)
+{
+    size_t xp = x;
+    size_t stride = text_spritesheet.width * text_spritesheet.height;
+    Sprite sprite = text_spritesheet;
+    for (const char *charp = text; *charp != '\0'; ++charp)
+    {
+        char character = *charp - 32;
+        if (character < 0 || character >= 65)
+            continue;
+        sprite.data = text_spritesheet.data + character * stride;
+        buffer_sprite_draw(buffer, sprite, xp, y, color);
+        xp += sprite.width + 1;
+    }
+}
+
+void buffer_number_draw(Buffer *buffer, const Sprite &number_spritesheet, size_t number,
+                        size_t x, size_t y, uint32_t color)
+{
+    uint8_t digits[64];
+    size_t num_digits = 0;
+
+    size_t current_number = number;
+    do
+    {
+        digits[num_digits++] = current_number % 10;
+        current_number /= 10;
+    } while (current_number > 0);
+
+    size_t xp = x;
+    size_t stride = number_spritesheet.width * number_spritesheet.height;
+    Sprite sprite = number_spritesheet;
+    for (size_t i = 0; i < num_digits; ++i)
+    {
+        uint8_t digit = digits[num_digits - i - 1];
+        sprite.data = number_spritesheet.data + digit * stride;
+        buffer_sprite_draw(buffer, sprite, xp, y, color);
+        xp += sprite.width + 1;
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "arena.h"
+
+struct Buffer
+{
+    size_t width, height;
+    uint32_t *data;
+};
+
+struct Sprite
+{
+    size_t width, height;
+    const uint8_t *data;
+};
+
+struct Alien
+{
+    size_t x, y;
+    uint8_t type;
+};
+
+struct Player
+{
+    size_t x, y;
+    size_t life;
+};
+
+struct Bullet
+{
+    size_t x, y;
+    int dir;
+};
+
+// Bunkers are bit-planes: one uint64_t per row, bit i is the i-th pixel from
+// the left, row 0 is the top. Bullets erode them with an explosion mask.
+#define BUNKER_WIDTH 22
+#define BUNKER_HEIGHT 16
+#define BUNKER_EXPLOSION_SIZE 8
+struct Bunker
+{
+    size_t x, y;
+    uint64_t rows[BUNKER_HEIGHT];
+};
+
+// Set in Game::events by the last game_update, for sound and other feedback
+enum GameEvent : uint32_t
+{
+    GAME_EVENT_FIRE = 1 << 0,
+    GAME_EVENT_ALIEN_HIT = 1 << 1,
+    GAME_EVENT_BUNKER_HIT = 1 << 2
+};
+
+#define GAME_MAX_BULLET 128
+#define GAME_MAX_ALIENS 55
+#define GAME_NUM_BUNKERS 4
+struct Game
+{
+    size_t width, height;
+    size_t num_aliens;
+    size_t num_bullets;
+    size_t score;
+    uint32_t events;
+    // Shots lost to a full bullet array, since game_init
+    size_t dropped_bullets;
+
+    Alien *aliens;
+    uint8_t *death_counters;
+    Player player;
+    Bullet bullets[GAME_MAX_BULLET];
+    Bunker bunkers[GAME_NUM_BUNKERS];
+};
+
+struct SpriteAnimation
+{
+    bool loop;
+    size_t num_frames;
+    size_t frame_duration;
+    size_t time;
+    Sprite **frames;
+};
+
+enum AlienType : uint8_t
+{
+    ALIEN_DEAD = 0,
+    ALIEN_TYPE_A = 1,
+    ALIEN_TYPE_B = 2,
+    ALIEN_TYPE_C = 3
+};
+
+// All sprites used by the game. The pixel data is static, so a GameSprites
+// can be copied freely and shared between any number of games.
+struct GameSprites
+{
+    Sprite alien_sprites[6];
+    Sprite alien_death_sprite;
+    Sprite player_sprite;
+    Sprite bullet_sprite;
+    Sprite text_spritesheet;
+    Sprite number_spritesheet;
+    Sprite bunker_sprite;
+    Sprite bunker_explosion_sprite;
+
+    // Bit-plane versions of the bunker sprites
+    uint64_t bunker_rows[BUNKER_HEIGHT];
+    uint64_t bunker_explosion_rows[BUNKER_EXPLOSION_SIZE];
+};
+
+// Alien grid at the start of a wave. Row 0 is the bottom row; types holds
+// one AlienType per row.
+struct Formation
+{
+    size_t rows, columns;
+    size_t spacing_x, spacing_y;
+    size_t x, y;
+    const uint8_t *types;
+};
+
+enum PaletteColor
+{
+    PALETTE_BACKGROUND = 0,
+    PALETTE_TEXT = 1,
+    PALETTE_GROUND = 2,
+    PALETTE_ALIEN = 3,
+    PALETTE_PLAYER = 4,
+    PALETTE_BULLET = 5,
+    PALETTE_BUNKER = 6,
+    PALETTE_NUM_COLORS = 7
+};
+
+// Colors as returned by rgb_to_uint32, indexed by PaletteColor
+struct Palette
+{
+    const uint32_t *colors;
+};
+
+void game_sprites_init(GameSprites *sprites);
+void game_formation_init(Formation *formation);
+void game_palette_init(Palette *palette);
+
+// Packs a sprite at most 64 pixels wide into one uint64_t per row.
+void sprite_bitplane_pack(const Sprite &sprite, uint64_t *rows);
+
+// Bytes game_init takes from its arena, including alignment padding.
+size_t game_arena_size();
+// Allocates the alien arrays from the arena; call game_reset before the first
+// update. They live as long as the arena.
+void game_init(Game *game, Arena *arena, size_t width, size_t height);
+void game_reset(Game *game, const GameSprites &sprites, const Formation &formation);
+// Rebuilds every bunker, undamaged, from sprites.bunker_rows.
+void game_bunkers_reset(Game *game, const GameSprites &sprites);
+
+// Advances the simulation by one tick and returns the score gained in it.
+size_t game_update(Game *game, const GameSprites &sprites, int move_dir, bool fire_pressed);
+
+// True once every alien is dead and its death sprite has faded out.
+bool game_cleared(const Game &game);
+
+void buffer_sprite_draw(Buffer *buffer, const Sprite &sprite, size_t x, size_t y, uint32_t color);
+
+void buffer_bunker_draw(Buffer *buffer, const Bunker &bunker, uint32_t color);
+
+bool sprite_overlap_check(const Sprite &sp_a, size_t x_a, size_t y_a,
+                          const Sprite &sp_b, size_t x_b, size_t y_b);
+
+uint32_t rgb_to_uint32(uint8_t r, uint8_t g, uint8_t b);
+
+void buffer_clear(Buffer *b, uint32_t col);
+
+void buffer_text_draw(Buffer *buffer, const Sprite &text_spritesheet, const char *text,
+                      size_t x, size_t y, uint32_t color);
+
+void buffer_number_draw(Buffer *buffer, const Sprite &number_spritesheet, size_t number,
+                        size_t x, size_t y, uint32_t color);
@@ -1,10 +1,20 @@
 #include <iostream>
+#include <chrono>
 #include <cstdint>
 #include <limits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include "alloc_tracker.h"
+#include "arena.h"
+#include "assets.h"
+#include "audio.h"
+#include "game.h"
+#include "metrics.h"
+
 bool game_running = false;
 int move_dir = 0;
 bool fire_pressed = 0;
@@ -124,150 +134,6 @@ void key_callback(GLFWwindow *win, int key, int scancode, int action, int mods)
     }
 }
 
-struct Buffer
-{
-    size_t width, height;
-    uint32_t *data;
-};
-
-struct Sprite
-{
-    size_t width, height;
-    uint8_t *data;
-};
-
-struct Alien
-{
-    size_t x, y;
-    uint8_t type;
-};
-
-struct Player
-{
-    size_t x, y;
-    size_t life;
-};
-
-struct Bullet
-{
-    size_t x, y;
-    int dir;
-};
-
-#define GAME_MAX_BULLET 128
-struct Game
-{
-    size_t width, height;
-    size_t num_aliens;
-    size_t num_bullets;
-
-    Alien *aliens;
-    Player player;
-    Bullet bullets[GAME_MAX_BULLET];
-};
-
-struct SpriteAnimation
-{
-    bool loop;
-    size_t num_frames;
-    size_t frame_duration;
-    size_t time;
-    Sprite **frames;
-};
-
-enum AlienType : u_int8_t
-{
-    ALIEN_DEAD = 0,
-    ALIEN_TYPE_A = 1,
-    ALIEN_TYPE_B = 2,
-    ALIEN_TYPE_C = 3
-};
-
-void buffer_sprite_draw(Buffer *buffer, const Sprite &sprite, size_t x, size_t y, uint32_t color)
-{
-    for (size_t xi = 0; xi < sprite.width; ++xi)
-    {
-        for (size_t yi = 0; yi < sprite.height; ++yi)
-        {
-            if (sprite.data[yi * sprite.width + xi] &&
-                (sprite.height - 1 + y - yi) < buffer->height &&
-                (x + xi) < buffer->width)
-            {
-                buffer->data[(sprite.height - 1 + y - yi) * buffer->width + (x + xi)] = color;
-            }
-        }
-    }
-}
-
-bool sprite_overlap_check(const Sprite &sp_a, size_t x_a, size_t y_a,
-                          const Sprite &sp_b, size_t x_b, size_t y_b)
-{
-    // NOTE: For simplicity we just check for overlap of the sprite rectangles.
-    if (x_a < x_b + sp_b.width && x_a + sp_a.width > x_b &&
-        y_a < y_b + sp_b.height && y_a + sp_a.width > y_b)
-    {
-        return true;
-    }
-    return false;
-}
-
-uint32_t rgb_to_uint32(uint8_t r, uint8_t g, uint8_t b)
-{
-    return (r << 24) | (g << 16) | (b << 8) | 255;
-    // sets the left-most 24 bits to the r, g, and b values respectively
-    // and last 8 bits to 255 for alpha
-}
-
-void buffer_clear(Buffer *b, uint32_t col)
-{
-    for (size_t i = 0; i < b->width * b->height; ++i)
-    {
-        b->data[i] = col;
-    }
-}
-
-void buffer_text_draw(Buffer *buffer, const Sprite &text_spritesheet, const char *text,
-                      size_t x, size_t y, uint32_t color)
-{
-    size_t xp = x;
-    size_t stride = text_spritesheet.width * text_spritesheet.height;
-    Sprite sprite = text_spritesheet;
-    for (const char *charp = text; *charp != '\0'; ++charp)
-    {
-        char character = *charp - 32;
-        if (character < 0 || character >= 65)
-            continue;
-        sprite.data = text_spritesheet.data + character * stride;
-        buffer_sprite_draw(buffer, sprite, xp, y, color);
-        xp += sprite.width + 1;
-    }
-}
-
-void buffer_number_draw(Buffer *buffer, Sprite &number_spritesheet, size_t number,
-                        size_t x, size_t y, uint32_t color)
-{
-    uint8_t digits[64];
-    size_t num_digits = 0;
-
-    size_t current_number = number;
-    do
-    {
-        digits[num_digits++] = current_number % 10;
-        current_number /= 10;
-    } while (current_number > 0);
-
-    size_t xp = x;
-    size_t stride = number_spritesheet.width * number_spritesheet.height;
-    Sprite sprite = number_spritesheet;
-    for (size_t i = 0; i < num_digits; ++i)
-    {
-        uint8_t digit = digits[num_digits - i - 1];
-        sprite.data = number_spritesheet.data + digit * stride;
-        buffer_sprite_draw(buffer, sprite, xp, y, color);
-        xp += sprite.width + 1;
-    }
-}
-
 std::string vertex_shader = R"glsl(
     #version 330
     noperspective out vec2 TexCoord;
@@ -335,11 +201,19 @@ int main(int, char **)
 
     glClearColor(.2f, .3f, .4f, 1.f);
 
+    // Everything the game and its mixer need lives in the persistent arena.
+    // The frame arena is reserved for scratch memory of a single frame and
+    // reset every frame; nothing draws from it yet.
+    Arena persistent_arena;
+    arena_init(&persistent_arena, "persistent", 1024 * 1024);
+    Arena frame_arena;
+    arena_init(&frame_arena, "frame", 64 * 1024);
+
     // Create graphic buffer
     Buffer buffer;
     buffer.width = buffer_width;
     buffer.height = buffer_height;
-    buffer.data = new uint32_t[buffer.width * buffer.height];
+    buffer.data = arena_push<uint32_t>(&persistent_arena, buffer.width * buffer.height);
 
     buffer_clear(&buffer, 0);
 
@@ -373,197 +247,33 @@ int main(int, char **)
     glBindVertexArray(fullscreen_triangle_vao);
 
     // Prepare Game
-    Sprite alien_sprites[6];
-
-    alien_sprites[0].width = 8;
-    alien_sprites[0].height = 8;
-    alien_sprites[0].data = new uint8_t[64]{
-        0, 0, 0, 1, 1, 0, 0, 0, // ...@@...
-        0, 0, 1, 1, 1, 1, 0, 0, // ..@@@@..
-        0, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@.
-        1, 1, 0, 1, 1, 0, 1, 1, // @@.@@.@@
-        1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@
-        0, 1, 0, 1, 1, 0, 1, 0, // .@.@@.@.
-        1, 0, 0, 0, 0, 0, 0, 1, // @......@
-        0, 1, 0, 0, 0, 0, 1, 0  // .@....@.
-    };
-
-    alien_sprites[1].width = 8;
-    alien_sprites[1].height = 8;
-    alien_sprites[1].data = new uint8_t[64]{
-        0, 0, 0, 1, 1, 0, 0, 0, // ...@@...
-        0, 0, 1, 1, 1, 1, 0, 0, // ..@@@@..
-        0, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@.
-        1, 1, 0, 1, 1, 0, 1, 1, // @@.@@.@@
-        1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@
-        0, 0, 1, 0, 0, 1, 0, 0, // ..@..@..
-        0, 1, 0, 1, 1, 0, 1, 0, // .@.@@.@.
-        1, 0, 1, 0, 0, 1, 0, 1  // @.@..@.@
-    };
-
-    alien_sprites[2].width = 11;
-    alien_sprites[2].height = 8;
-    alien_sprites[2].data = new uint8_t[88]{
-        0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, // ..@.....@..
-        0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, // ...@...@...
-        0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, // ..@@@@@@@..
-        0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, // .@@.@@@.@@.
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
-        1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 1, // @.@@@@@@@.@
-        1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, // @.@.....@.@
-        0, 0, 0, 1, 1, 0, 1, 1, 0, 0, 0  // ...@@.@@...
-    };
-
-    alien_sprites[3].width = 11;
-    alien_sprites[3].height = 8;
-    alien_sprites[3].data = new uint8_t[88]{
-        0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, // ..@.....@..
-        1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, // @..@...@..@
-        1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 1, // @.@@@@@@@.@
-        1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, // @@@.@@@.@@@
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@.
-        0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, // ..@.....@..
-        0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0  // .@.......@.
-    };
-
-    alien_sprites[4].width = 12;
-    alien_sprites[4].height = 8;
-    alien_sprites[4].data = new uint8_t[96]{
-        0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, // ....@@@@....
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@@.
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
-        1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, // @@@..@@..@@@
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
-        0, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, // ...@@..@@...
-        0, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, // ..@@.@@.@@..
-        1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1  // @@........@@
-    };
-
-    alien_sprites[5].width = 12;
-    alien_sprites[5].height = 8;
-    alien_sprites[5].data = new uint8_t[96]{
-        0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, // ....@@@@....
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@@.
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
-        1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, // @@@..@@..@@@
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@@
-        0, 0, 1, 1, 1, 0, 0, 1, 1, 1, 0, 0, // ..@@@..@@@..
-        0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, // .@@..@@..@@.
-        0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0  // ..@@....@@..
-    };
-
-    Sprite alien_death_sprite;
-    alien_death_sprite.width = 13;
-    alien_death_sprite.height = 7;
-    alien_death_sprite.data = new uint8_t[91]{
-        0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, // .@..@...@..@.
-        0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, // ..@..@.@..@..
-        0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, // ...@.....@...
-        1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, // @@.........@@
-        0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, // ...@.....@...
-        0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, // ..@..@.@..@..
-        0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0  // .@..@...@..@.
-    };
-
-    Sprite player_sprite;
-    player_sprite.width = 11;
-    player_sprite.height = 7;
-    player_sprite.data = new uint8_t[77]{
-        0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, // .....@.....
-        0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, // ....@@@....
-        0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, // ....@@@....
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, // .@@@@@@@@@.
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // @@@@@@@@@@@
-    };
-
-    Sprite bullet_sprite;
-    bullet_sprite.width = 1;
-    bullet_sprite.height = 3;
-    bullet_sprite.data = new uint8_t[3]{
-        1, // @
-        1, // @
-        1  // @
-    };
-
-    Sprite text_spritesheet;
-    text_spritesheet.width = 5;
-    text_spritesheet.height = 7;
-    text_spritesheet.data = new uint8_t[65 * 35]{
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
-        0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0,
-        0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 0,
-        1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1,
-        0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1,
-        0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
-        1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0,
-        0, 0, 1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
-        0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
-
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
-        1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-
-        0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
-        0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-
-        0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
-        1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
-        1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
-        0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0,
-        0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1,
-        1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1,
-        1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1,
-        0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 0, 0, 1,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1,
-        1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
-        1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1,
-
-        0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1,
-        0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
-        1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0,
-        0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
-        0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-    Sprite number_spritesheet = text_spritesheet;
-    number_spritesheet.data += 16 * 35;
+    GameSprites sprites;
+    game_sprites_init(&sprites);
+    Formation formation;
+    game_formation_init(&formation);
+    Palette palette;
+    game_palette_init(&palette);
+
+    // Assets from a pack (SIC_ASSET_PACK, sic.pack by default) replace the
+    // built-in ones, and are reloaded between frames when the pack changes.
+    // Two slots let the new pack load while the old one is still in use.
+    const char *asset_path = getenv("SIC_ASSET_PACK");
+    if (!asset_path)
+        asset_path = "sic.pack";
+    AssetPack asset_packs[2];
+    AssetPack *asset_pack = nullptr;
+    if (asset_pack_load(&asset_packs[0], asset_path))
+    {
+        asset_pack = &asset_packs[0];
+        sprites = asset_pack->sprites;
+        formation = asset_pack->formation;
+        palette = asset_pack->palette;
+    }
+    AssetWatcher asset_watcher;
+    if (!asset_watch_init(&asset_watcher, asset_path))
+    {
+        std::cerr << "Cannot watch " << asset_path << " for changes" << std::endl;
+    }
 
     SpriteAnimation alien_animation[3];
 
@@ -574,97 +284,107 @@ int main(int, char **)
         alien_animation[i].frame_duration = 10;
         alien_animation[i].time = 0;
 
-        alien_animation[i].frames = new Sprite *[2];
-        alien_animation[i].frames[0] = &alien_sprites[2 * i];
-        alien_animation[i].frames[1] = &alien_sprites[2 * i + 1];
+        alien_animation[i].frames = arena_push<Sprite *>(&persistent_arena, 2);
+        alien_animation[i].frames[0] = &sprites.alien_sprites[2 * i];
+        alien_animation[i].frames[1] = &sprites.alien_sprites[2 * i + 1];
     }
 
     Game game;
-    game.width = buffer_width;
-    game.height = buffer_height;
-    game.num_aliens = 55;
-    game.num_bullets = 0;
-    game.aliens = new Alien[game.num_aliens];
-
-    game.player.x = 122 - 5;
-    game.player.y = 32;
+    game_init(&game, &persistent_arena, buffer_width, buffer_height);
+    game_reset(&game, sprites, formation);
 
-    game.player.life = 3;
-
-    for (size_t yi = 0; yi < 5; ++yi)
+    // Sound, written to a WAV file if SIC_AUDIO_WAV names one
+    AudioBackend audio_backend = audio_null_backend();
+    const char *audio_wav_path = getenv("SIC_AUDIO_WAV");
+    if (audio_wav_path && !audio_wav_backend(&audio_backend, &persistent_arena, audio_wav_path))
     {
-        for (size_t xi = 0; xi < 11; ++xi)
-        {
-            Alien &alien = game.aliens[yi * 11 + xi];
-            alien.type = (5 - yi) / 2 + 1;
+        std::cerr << "Cannot open " << audio_wav_path << std::endl;
+    }
+    Audio *audio = audio_create(&persistent_arena, audio_backend);
+    audio_start(audio);
 
-            const Sprite &sprite = alien_sprites[2 * (alien.type - 1)];
+    // The march plays one of four notes every march_period frames
+    const size_t march_period = 48;
+    size_t march_timer = 0;
+    size_t march_note = 0;
 
-            alien.x = 16 * xi + 20 + (alien_death_sprite.width - sprite.width) / 2;
-            alien.y = 17 * yi + 128;
-        }
-    }
+    game_running = true;
 
-    uint8_t *death_counters = new uint8_t[game.num_aliens];
-    for (size_t i = 0; i < game.num_aliens; ++i)
+    size_t credits = 0;
+
+    // Live counters for external monitors, in shared memory named by
+    // SIC_METRICS (/sic_metrics by default)
+    const char *metrics_name = getenv("SIC_METRICS");
+    if (!metrics_name)
+        metrics_name = METRICS_SHM_NAME;
+    MetricsWriter metrics;
+    if (!metrics_writer_init(&metrics, metrics_name))
     {
-        death_counters[i] = 10;
+        std::cerr << "Cannot create shared memory " << metrics_name
+                  << " (is another game publishing there?)" << std::endl;
     }
 
-    uint32_t clear_color = rgb_to_uint32(0, 128, 0);
+    using clock = std::chrono::steady_clock;
+    clock::time_point frame_start = clock::now();
+    clock::time_point tick_window_start = frame_start;
+    uint64_t frames = 0;
+    uint64_t ticks_in_window = 0;
 
-    game_running = true;
-
-    int player_move_dir = 0;
-    size_t score = 0;
-    size_t credits = 0;
+    // The frame loop must not touch the heap
+    alloc_phase_set(ALLOC_PHASE_FRAME);
 
     while (!glfwWindowShouldClose(window) && game_running)
     {
-        buffer_clear(&buffer, clear_color);
+        arena_reset(&frame_arena);
+        buffer_clear(&buffer, palette.colors[PALETTE_BACKGROUND]);
 
         // Draw
 
-        buffer_text_draw(&buffer, text_spritesheet, "SCORE", 4, game.height - text_spritesheet.height - 7, rgb_to_uint32(128, 0, 0));
+        buffer_text_draw(&buffer, sprites.text_spritesheet, "SCORE", 4, game.height - sprites.text_spritesheet.height - 7, palette.colors[PALETTE_TEXT]);
 
         char credit_text[16];
         sprintf(credit_text, "CREDIT %02lu", credits);
-        buffer_text_draw(&buffer, text_spritesheet, credit_text, 164, 7, rgb_to_uint32(128, 0, 0));
+        buffer_text_draw(&buffer, sprites.text_spritesheet, credit_text, 164, 7, palette.colors[PALETTE_TEXT]);
 
-        buffer_number_draw(&buffer, number_spritesheet, score, 4 + 2 * number_spritesheet.width, game.height - 2 * number_spritesheet.height - 12, rgb_to_uint32(128, 0, 0));
+        buffer_number_draw(&buffer, sprites.number_spritesheet, game.score, 4 + 2 * sprites.number_spritesheet.width, game.height - 2 * sprites.number_spritesheet.height - 12, palette.colors[PALETTE_TEXT]);
 
         for (size_t i = 0; i < game.width; ++i)
         {
-            buffer.data[game.width * 16 + i] = rgb_to_uint32(128, 0, 0);
+            buffer.data[game.width * 16 + i] = palette.colors[PALETTE_GROUND];
         }
 
         for (size_t ai = 0; ai < game.num_aliens; ++ai)
         {
-            if (!death_counters[ai])
+            if (!game.death_counters[ai])
                 continue;
 
             const Alien &alien = game.aliens[ai];
             if (alien.type == ALIEN_DEAD)
             {
-                buffer_sprite_draw(&buffer, alien_death_sprite, alien.x, alien.y, rgb_to_uint32(128, 0, 0));
+                buffer_sprite_draw(&buffer, sprites.alien_death_sprite, alien.x, alien.y, palette.colors[PALETTE_ALIEN]);
             }
             else
             {
                 const SpriteAnimation &animation = alien_animation[alien.type - 1];
                 size_t current_frame = animation.time / animation.frame_duration;
                 const Sprite &sprite = *animation.frames[current_frame];
-                buffer_sprite_draw(&buffer, sprite, alien.x, alien.y, rgb_to_uint32(128, 0, 0));
+                buffer_sprite_draw(&buffer, sprite, alien.x, alien.y, palette.colors[PALETTE_ALIEN]);
             }
         }
 
+        for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i)
+        {
+            buffer_bunker_draw(&buffer, game.bunkers[i], palette.colors[PALETTE_BUNKER]);
+        }
+
         for (size_t bi = 0; bi < game.num_bullets; ++bi)
         {
             const Bullet &bullet = game.bullets[bi];
-            const Sprite &sprite = bullet_sprite;
-            buffer_sprite_draw(&buffer, sprite, bullet.x, bullet.y, rgb_to_uint32(128, 0, 0));
+            const Sprite &sprite = sprites.bullet_sprite;
+            buffer_sprite_draw(&buffer, sprite, bullet.x, bullet.y, palette.colors[PALETTE_BULLET]);
         }
 
-        buffer_sprite_draw(&buffer, player_sprite, game.player.x, game.player.y, rgb_to_uint32(128, 0, 0));
+        buffer_sprite_draw(&buffer, sprites.player_sprite, game.player.x, game.player.y, palette.colors[PALETTE_PLAYER]);
 
         // Update animations
         for (size_t i = 0; i < 3; ++i)
@@ -676,111 +396,124 @@ int main(int, char **)
             }
         }
 
+        clock::time_point upload_start = clock::now();
         glTexSubImage2D(
             GL_TEXTURE_2D, 0, 0, 0,
             buffer.width, buffer.height,
             GL_RGBA, GL_UNSIGNED_INT_8_8_8_8,
             buffer.data);
+        metrics_set(&metrics, METRIC_UPLOAD_TIME_NS,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - upload_start).count());
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         glfwSwapBuffers(window);
 
-        // Simulate aliens
-        for (size_t ai = 0; ai < game.num_aliens; ++ai)
+        // Simulate
+        game_update(&game, sprites, move_dir, fire_pressed);
+        fire_pressed = false;
+        ++ticks_in_window;
+
+        // Sound
+        if (game.events & GAME_EVENT_FIRE)
+            audio_play(audio, AUDIO_SOUND_FIRE, AUDIO_GAIN_ONE);
+        if (game.events & GAME_EVENT_ALIEN_HIT)
+            audio_play(audio, AUDIO_SOUND_EXPLOSION, AUDIO_GAIN_ONE);
+        if (game.events & GAME_EVENT_BUNKER_HIT)
+            audio_play(audio, AUDIO_SOUND_EXPLOSION, AUDIO_GAIN_ONE / 4);
+
+        if (++march_timer == march_period && !game_cleared(game))
         {
-            const Alien &alien = game.aliens[ai];
-            if (alien.type == ALIEN_DEAD && death_counters[ai])
-            {
-                --death_counters[ai];
-            }
+            audio_play(audio, (AudioSound)(AUDIO_SOUND_MARCH_0 + march_note), AUDIO_GAIN_ONE);
+            march_note = (march_note + 1) % 4;
         }
+        march_timer %= march_period;
 
-        // Simulate bullets
-        for (size_t bi = 0; bi < game.num_bullets;)
+        // Reload assets
+        if (asset_watch_changed(&asset_watcher))
         {
-            game.bullets[bi].y += game.bullets[bi].dir;
-            if (game.bullets[bi].y >= game.height || game.bullets[bi].y < bullet_sprite.height)
+            AssetPack *next_pack = asset_pack == &asset_packs[0] ? &asset_packs[1] : &asset_packs[0];
+            if (asset_pack_load(next_pack, asset_path))
             {
-                game.bullets[bi] = game.bullets[game.num_bullets - 1];
-                --game.num_bullets;
-                continue;
+                const Formation &next_formation = next_pack->formation;
+                bool formation_changed =
+                    next_formation.rows != formation.rows || next_formation.columns != formation.columns ||
+                    next_formation.spacing_x != formation.spacing_x || next_formation.spacing_y != formation.spacing_y ||
+                    next_formation.x != formation.x || next_formation.y != formation.y ||
+                    memcmp(next_formation.types, formation.types, formation.rows) != 0;
+                // Live bunkers hold their own copy of the rows
+                bool bunker_changed = memcmp(next_pack->sprites.bunker_rows, sprites.bunker_rows,
+                                             sizeof(sprites.bunker_rows)) != 0;
+
+                sprites = next_pack->sprites;
+                formation = next_pack->formation;
+                palette = next_pack->palette;
+                if (asset_pack)
+                    asset_pack_unload(asset_pack);
+                asset_pack = next_pack;
+
+                // A new formation starts a new wave and a new bunker shape
+                // rebuilds the bunkers; anything else shows up in place
+                if (formation_changed)
+                    game_reset(&game, sprites, formation);
+                else if (bunker_changed)
+                    game_bunkers_reset(&game, sprites);
             }
-
-            // Check hit
-            for (size_t ai = 0; ai < game.num_aliens; ++ai)
-            {
-                const Alien &alien = game.aliens[ai];
-                if (alien.type == ALIEN_DEAD)
-                    continue;
-
-                const SpriteAnimation &animation = alien_animation[alien.type - 1];
-                size_t current_frame = animation.time / animation.frame_duration;
-                const Sprite &alien_sprite = *animation.frames[current_frame];
-                bool overlap = sprite_overlap_check(
-                    bullet_sprite, game.bullets[bi].x, game.bullets[bi].y,
-                    alien_sprite, alien.x, alien.y);
-                if (overlap)
-                {
-                    score += 10 * (4 - game.aliens[ai].type);
-                    game.aliens[ai].type = ALIEN_DEAD;
-                    // NOTE: Hack to recenter death sprite
-                    game.aliens[ai].x -= (alien_death_sprite.width - alien_sprite.width) / 2;
-                    game.bullets[bi] = game.bullets[game.num_bullets - 1];
-                    --game.num_bullets;
-                    continue;
-                }
-            }
-
-            ++bi;
         }
 
-        // Simulate player
-        player_move_dir = 2 * move_dir;
+        glfwPollEvents();
 
-        if (player_move_dir != 0)
+        // Publish metrics
+        clock::time_point frame_end = clock::now();
+        metrics_frame_time(&metrics, std::chrono::duration_cast<std::chrono::nanoseconds>(frame_end - frame_start).count());
+        frame_start = frame_end;
+
+        if (frame_end - tick_window_start >= std::chrono::seconds(1))
         {
-            if (game.player.x + player_sprite.width + player_move_dir >= game.width)
-            {
-                game.player.x = game.width - player_sprite.width;
-            }
-            else if ((int)game.player.x + player_move_dir <= 0)
-            {
-                game.player.x = 0;
-            }
-            else
-                game.player.x += player_move_dir;
+            double window = std::chrono::duration<double>(frame_end - tick_window_start).count();
+            metrics_set(&metrics, METRIC_SIM_TICKS_PER_SECOND, (uint64_t)(ticks_in_window / window + 0.5));
+            tick_window_start = frame_end;
+            ticks_in_window = 0;
         }
 
-        // Process events
-        if (fire_pressed && game.num_bullets < GAME_MAX_BULLET)
+        size_t live_aliens = 0;
+        for (size_t ai = 0; ai < game.num_aliens; ++ai)
         {
-            game.bullets[game.num_bullets].x = game.player.x + player_sprite.width / 2;
-            game.bullets[game.num_bullets].y = game.player.y + player_sprite.height;
-            game.bullets[game.num_bullets].dir = 2;
-            ++game.num_bullets;
+            live_aliens += game.aliens[ai].type != ALIEN_DEAD;
         }
-        fire_pressed = false;
 
-        glfwPollEvents();
+        metrics_set(&metrics, METRIC_FRAMES, ++frames);
+        metrics_set(&metrics, METRIC_LIVE_ALIENS, live_aliens);
+        metrics_set(&metrics, METRIC_BULLETS, game.num_bullets);
+        metrics_set(&metrics, METRIC_DROPPED_BULLETS, game.dropped_bullets);
+        metrics_set(&metrics, METRIC_SCORE, game.score);
+        metrics_publish(&metrics);
     }
 
+    alloc_phase_set(ALLOC_PHASE_SHUTDOWN);
+
+    metrics_writer_free(&metrics);
+
+    audio_destroy(audio);
+
+    asset_watch_free(&asset_watcher);
+    if (asset_pack)
+        asset_pack_unload(asset_pack);
+
     glfwDestroyWindow(window);
     glfwTerminate();
 
     glDeleteVertexArrays(1, &fullscreen_triangle_vao);
 
-    for (size_t i = 0; i < 6; ++i)
-    {
-        delete[] alien_sprites[i].data;
-    }
-
-    delete[] alien_death_sprite.data;
+    arena_free(&frame_arena);
+    arena_free(&persistent_arena);
 
-    for (size_t i = 0; i < 3; ++i)
+    if (alloc_tracking_enabled())
     {
-        delete[] alien_animation[i].frames;
+        alloc_tracker_report(stderr);
+        if (alloc_phase_stats(ALLOC_PHASE_FRAME).count)
+        {
+            std::cerr << "Error! The frame loop allocated from the heap" << std::endl;
+            return 1;
+        }
     }
-    delete[] buffer.data;
-    delete[] game.aliens;
-    delete[] death_counters;
 }
@@ -0,0 +1,195 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+const char *metric_names[METRIC_COUNT] = {
+    "frames",
+    "frame_time_p50_ns",
+    "frame_time_p95_ns",
+    "frame_time_p99_ns",
+    "frame_time_max_ns",
+    "sim_ticks_per_second",
+    "upload_time_ns",
+    "live_aliens",
+    "bullets",
+    "dropped_bullets",
+    "score"};
+
+bool metrics_writer_init(MetricsWriter *writer, const char *name)
+{
+    writer->shared = nullptr;
+    writer->fd = -1;
+    memset(writer->values, 0, sizeof(writer->values));
+    writer->num_frame_times = 0;
+    writer->next_frame_time = 0;
+
+    // The segment is never unlinked, so every writer locks the same file. A
+    // lock is released when its process exits, however that happens, so a
+    // free lock means whatever is left in the segment can be reclaimed.
+    int fd = shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+
+    struct flock lock = {};
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    if (fcntl(fd, F_SETLK, &lock) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(MetricsShared)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(nullptr, sizeof(MetricsShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    // A segment left by a crashed game is reused in place, so a monitor still
+    // attached to it keeps working. Hide the header and clear the values under
+    // the seqlock before publishing the new header.
+    MetricsShared *shared = (MetricsShared *)map;
+    shared->magic = 0;
+    uint32_t sequence = shared->sequence.load(std::memory_order_relaxed) | 1;
+    shared->sequence.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < METRIC_COUNT; ++i)
+    {
+        shared->values[i].store(0, std::memory_order_relaxed);
+    }
+    shared->sequence.store(sequence + 1, std::memory_order_release);
+
+    shared->version = METRICS_VERSION;
+    shared->pid = getpid();
+    shared->num_metrics = METRIC_COUNT;
+    std::atomic_thread_fence(std::memory_order_release);
+    shared->magic = METRICS_MAGIC;
+
+    writer->shared = shared;
+    writer->fd = fd;
+    return true;
+}
+
+void metrics_writer_free(MetricsWriter *writer)
+{
+    if (!writer->shared)
+        return;
+
+    // Closing the descriptor releases the lock. The segment stays for the next
+    // game to reclaim; removing it would race with one starting right now.
+    munmap(writer->shared, sizeof(MetricsShared));
+    close(writer->fd);
+    writer->shared = nullptr;
+    writer->fd = -1;
+}
+
+void metrics_set(MetricsWriter *writer, Metric metric, uint64_t value)
+{
+    writer->values[metric] = value;
+}
+
+void metrics_frame_time(MetricsWriter *writer, uint64_t ns)
+{
+    writer->frame_times[writer->next_frame_time] = ns;
+    writer->next_frame_time = (writer->next_frame_time + 1) % METRICS_FRAME_WINDOW;
+    if (writer->num_frame_times < METRICS_FRAME_WINDOW)
+        ++writer->num_frame_times;
+
+    uint64_t sorted[METRICS_FRAME_WINDOW];
+    size_t n = writer->num_frame_times;
+    std::copy(writer->frame_times, writer->frame_times + n, sorted);
+    std::sort(sorted, sorted + n);
+
+    writer->values[METRIC_FRAME_TIME_P50_NS] = sorted[n * 50 / 100];
+    writer->values[METRIC_FRAME_TIME_P95_NS] = sorted[n * 95 / 100];
+    writer->values[METRIC_FRAME_TIME_P99_NS] = sorted[n * 99 / 100];
+    writer->values[METRIC_FRAME_TIME_MAX_NS] = sorted[n - 1];
+}
+
+void metrics_publish(MetricsWriter *writer)
+{
+    MetricsShared *shared = writer->shared;
+    if (!shared)
+        return;
+
+    uint32_t sequence = shared->sequence.load(std::memory_order_relaxed);
+    shared->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < METRIC_COUNT; ++i)
+    {
+        shared->values[i].store(writer->values[i], std::memory_order_relaxed);
+    }
+
+    shared->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+const MetricsShared *metrics_open(const char *name)
+{
+    int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+        return nullptr;
+
+    // Without a writer holding the lock the segment is left over from a game
+    // that has exited
+    struct flock lock = {};
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    if (fcntl(fd, F_GETLK, &lock) != 0 || lock.l_type == F_UNLCK)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void *map = mmap(nullptr, sizeof(MetricsShared), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return nullptr;
+
+    const MetricsShared *shared = (const MetricsShared *)map;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (shared->magic != METRICS_MAGIC || shared->version != METRICS_VERSION)
+    {
+        munmap(map, sizeof(MetricsShared));
+        return nullptr;
+    }
+    return shared;
+}
+
+void metrics_close(const MetricsShared *shared)
+{
+    munmap((void *)shared, sizeof(MetricsShared));
+}
+
+bool metrics_read(const MetricsShared *shared, uint64_t values[METRIC_COUNT])
+{
+    for (int attempt = 0; attempt < 1000; ++attempt)
+    {
+        uint32_t before = shared->sequence.load(std::memory_order_acquire);
+        if (before & 1)
+            continue;
+
+        for (size_t i = 0; i < METRIC_COUNT; ++i)
+        {
+            values[i] = shared->values[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t after = shared->sequence.load(std::memory_order_relaxed);
+        if (before == after)
+            return true;
+    }
+    return false;
+}
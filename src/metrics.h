@@ -0,0 +1,80 @@
+#pragma once
+
+// Live counters published to a POSIX shared-memory segment for external
+// monitors such as sic_top. The game writes them under a seqlock: publishing
+// is a handful of plain stores with no syscalls, and readers retry instead of
+// ever blocking the writer.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#define METRICS_SHM_NAME "/sic_metrics"
+#define METRICS_MAGIC 0x4d434953 // "SICM"
+#define METRICS_VERSION 1
+// Frames the frame time percentiles are taken over
+#define METRICS_FRAME_WINDOW 128
+
+enum Metric
+{
+    METRIC_FRAMES = 0,
+    METRIC_FRAME_TIME_P50_NS = 1,
+    METRIC_FRAME_TIME_P95_NS = 2,
+    METRIC_FRAME_TIME_P99_NS = 3,
+    METRIC_FRAME_TIME_MAX_NS = 4,
+    METRIC_SIM_TICKS_PER_SECOND = 5,
+    METRIC_UPLOAD_TIME_NS = 6,
+    METRIC_LIVE_ALIENS = 7,
+    METRIC_BULLETS = 8,
+    METRIC_DROPPED_BULLETS = 9,
+    METRIC_SCORE = 10,
+    METRIC_COUNT = 11
+};
+
+extern const char *metric_names[METRIC_COUNT];
+
+// Layout of the segment. sequence is odd while the writer is updating values.
+struct MetricsShared
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pid;
+    uint32_t num_metrics;
+    alignas(64) std::atomic<uint32_t> sequence;
+    alignas(64) std::atomic<uint64_t> values[METRIC_COUNT];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "metrics need address-free atomics");
+
+struct MetricsWriter
+{
+    MetricsShared *shared;
+    // Holds a write lock on the segment for as long as the writer lives
+    int fd;
+
+    uint64_t values[METRIC_COUNT];
+    uint64_t frame_times[METRICS_FRAME_WINDOW];
+    size_t num_frame_times;
+    size_t next_frame_time;
+};
+
+// Creates the segment, or reclaims one left behind by a game that exited.
+// Fails if another process holds the segment's lock. The lock is a POSIX
+// record lock, which closing any descriptor of the segment drops, so the
+// writing process must not call metrics_open on its own segment.
+bool metrics_writer_init(MetricsWriter *writer, const char *name);
+// Unmaps the segment and releases its lock.
+void metrics_writer_free(MetricsWriter *writer);
+
+void metrics_set(MetricsWriter *writer, Metric metric, uint64_t value);
+// Adds a frame time and updates the percentile metrics.
+void metrics_frame_time(MetricsWriter *writer, uint64_t ns);
+// Copies all values set since the last publish into the segment.
+void metrics_publish(MetricsWriter *writer);
+
+// Maps a segment read-only; nullptr if there is none or no writer holds it.
+const MetricsShared *metrics_open(const char *name);
+void metrics_close(const MetricsShared *shared);
+// Takes a consistent snapshot of every value. Returns false if the writer
+// kept the segment busy for every attempt.
+bool metrics_read(const MetricsShared *shared, uint64_t values[METRIC_COUNT]);
@@ -0,0 +1,64 @@
+// Mixes a dense stream of sound effects offline and reports how much faster
+// than real time the mixer runs. Writes the result to a WAV file if given one.
+//
+// usage: sic_audio_bench [seconds] [out.wav]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "alloc_tracker.h"
+#include "arena.h"
+#include "audio.h"
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 60.0;
+
+    Arena arena;
+    arena_init(&arena, "audio", audio_arena_size());
+
+    AudioBackend backend = audio_null_backend();
+    if (argc > 2 && !audio_wav_backend(&backend, &arena, argv[2]))
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[2]);
+        return 1;
+    }
+
+    Audio *audio = audio_create(&arena, backend);
+
+    // One game frame of audio at 60 Hz, with a new sound every frame so all
+    // voices stay busy
+    const size_t frame_length = AUDIO_SAMPLE_RATE / 60;
+    size_t num_frames = (size_t)(seconds * 60);
+
+    alloc_phase_set(ALLOC_PHASE_FRAME);
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point start = clock::now();
+    for (size_t i = 0; i < num_frames; ++i)
+    {
+        audio_play(audio, (AudioSound)(i % AUDIO_NUM_SOUNDS), AUDIO_GAIN_ONE / 2);
+        audio_render(audio, frame_length);
+    }
+    double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+    alloc_phase_set(ALLOC_PHASE_SHUTDOWN);
+
+    printf("mixed %.1f s of audio in %.3f s (%.0fx real time), %zu dropped commands\n",
+           seconds, elapsed, seconds / elapsed, audio_dropped_commands(audio));
+
+    audio_destroy(audio);
+    arena_free(&arena);
+
+    if (alloc_tracking_enabled())
+    {
+        alloc_tracker_report(stdout);
+        if (alloc_phase_stats(ALLOC_PHASE_FRAME).count)
+        {
+            fprintf(stderr, "The steady-state loop allocated from the heap\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Steps a batch of headless games with random actions and reports throughput.
+//
+// usage: sic_env_bench [num_envs] [num_threads] [pixels|features] [seconds]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "alloc_tracker.h"
+#include "env.h"
+
+int main(int argc, char **argv)
+{
+    size_t num_envs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1024;
+    size_t num_threads = argc > 2 ? strtoul(argv[2], nullptr, 10) : 0;
+    int obs_mode = argc > 3 && strcmp(argv[3], "features") == 0 ? SIC_OBS_FEATURES : SIC_OBS_PIXELS;
+    double seconds = argc > 4 ? atof(argv[4]) : 5.0;
+
+    SicEnv *env = sic_env_create(num_envs, num_threads, obs_mode, 4096);
+    if (!env)
+    {
+        fprintf(stderr, "Cannot create environment\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> obs(num_envs * sic_env_obs_size(env));
+    std::vector<uint8_t> actions(num_envs);
+    std::vector<float> reward(num_envs);
+    std::vector<uint8_t> done(num_envs);
+
+    sic_env_reset(env, nullptr, obs.data());
+
+    alloc_phase_set(ALLOC_PHASE_FRAME);
+
+    std::mt19937 rng(1);
+    using clock = std::chrono::steady_clock;
+    clock::time_point start = clock::now();
+    size_t steps = 0;
+    size_t episodes = 0;
+    double total_reward = 0;
+    double elapsed = 0;
+    while (elapsed < seconds)
+    {
+        for (size_t i = 0; i < num_envs; ++i)
+        {
+            actions[i] = rng() % SIC_NUM_ACTIONS;
+        }
+        sic_env_step(env, actions.data(), obs.data(), reward.data(), done.data());
+        for (size_t i = 0; i < num_envs; ++i)
+        {
+            total_reward += reward[i];
+            episodes += done[i];
+        }
+        steps += num_envs;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    alloc_phase_set(ALLOC_PHASE_SHUTDOWN);
+
+    printf("%zu envs, %s obs (%zu bytes): %.0f steps/s, %zu episodes, mean reward/step %.3f\n",
+           num_envs, obs_mode == SIC_OBS_PIXELS ? "pixel" : "feature", sic_env_obs_size(env),
+           steps / elapsed, episodes, total_reward / steps);
+
+    sic_env_destroy(env);
+
+    if (alloc_tracking_enabled())
+    {
+        alloc_tracker_report(stdout);
+        if (alloc_phase_stats(ALLOC_PHASE_FRAME).count)
+        {
+            fprintf(stderr, "The steady-state loop allocated from the heap\n");
+            return 1;
+        }
+    }
+    return 0;
+}
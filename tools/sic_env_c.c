@@ -0,0 +1,211 @@
+/* Drives the environment from C, so env.h stays usable as a C header, and
+ * checks the behavior env.h documents. Exits non-zero on any mismatch.
+ *
+ * usage: sic_env_c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "env.h"
+
+/* Mirrors game.h, which C cannot include */
+#define MAX_ALIENS 55
+#define MAX_BULLETS 128
+#define NUM_FEATURES (3 + 3 * MAX_ALIENS + 2 * MAX_BULLETS)
+/* Score of the default formation: 11 columns of one C, two B and two A rows */
+#define WAVE_SCORE (11 * (30 + 2 * 20 + 2 * 10))
+
+enum
+{
+    F_PLAYER_X = 0,
+    F_NUM_BULLETS = 2,
+    F_ALIENS = 3,
+    F_BULLETS = 3 + 3 * MAX_ALIENS
+};
+
+static int failures = 0;
+
+static void check(int ok, const char *what, size_t env, size_t step)
+{
+    if (ok)
+        return;
+    if (failures < 10)
+        fprintf(stderr, "env %zu step %zu: %s\n", env, step, what);
+    ++failures;
+}
+
+/* obs carries no alignment guarantee, so features are copied out */
+static void features_read(const uint8_t *obs, int16_t *features)
+{
+    memcpy(features, obs, NUM_FEATURES * sizeof(int16_t));
+}
+
+static int features_padding_zero(const int16_t *features)
+{
+    /* Alien slots past the formation are all zero, and nothing follows them */
+    int past_formation = 0;
+    for (size_t ai = 0; ai < MAX_ALIENS; ++ai)
+    {
+        const int16_t *alien = features + F_ALIENS + 3 * ai;
+        int empty = alien[0] == 0 && alien[1] == 0 && alien[2] == 0;
+        if (past_formation && !empty)
+            return 0;
+        past_formation = past_formation || empty;
+    }
+
+    int16_t num_bullets = features[F_NUM_BULLETS];
+    if (num_bullets < 0 || num_bullets > MAX_BULLETS)
+        return 0;
+    for (size_t fi = F_BULLETS + 2 * (size_t)num_bullets; fi < NUM_FEATURES; ++fi)
+    {
+        if (features[fi])
+            return 0;
+    }
+    return 1;
+}
+
+/* Score of the aliens alive in before and hit in after */
+static int features_kill_score(const int16_t *before, const int16_t *after)
+{
+    int score = 0;
+    for (size_t ai = 0; ai < MAX_ALIENS; ++ai)
+    {
+        int type = before[F_ALIENS + 3 * ai];
+        if (type && !after[F_ALIENS + 3 * ai])
+            score += 10 * (4 - type);
+    }
+    return score;
+}
+
+/* Moves under the nearest live alien while firing */
+static uint8_t policy_aim(const int16_t *features)
+{
+    int player_x = features[F_PLAYER_X];
+    int best = -1, best_dx = 0;
+    for (size_t ai = 0; ai < MAX_ALIENS; ++ai)
+    {
+        const int16_t *alien = features + F_ALIENS + 3 * ai;
+        if (!alien[0])
+            continue;
+        int dx = alien[1] - player_x;
+        if (best < 0 || abs(dx) < abs(best_dx))
+        {
+            best = (int)ai;
+            best_dx = dx;
+        }
+    }
+    if (best < 0 || best_dx == 0)
+        return SIC_ACTION_FIRE;
+    return best_dx < 0 ? SIC_ACTION_LEFT_FIRE : SIC_ACTION_RIGHT_FIRE;
+}
+
+/* Runs num_envs games for steps ticks and checks rewards, done flags, resets
+ * and padding along the way. Returns the number of finished episodes. */
+static size_t run(size_t num_envs, size_t num_threads, size_t max_steps, size_t steps, int aim)
+{
+    SicEnv *env = sic_env_create(num_envs, num_threads, SIC_OBS_FEATURES, max_steps);
+    if (!env)
+    {
+        fprintf(stderr, "Cannot create environment\n");
+        exit(1);
+    }
+
+    size_t obs_size = sic_env_obs_size(env);
+    check(sic_env_num_envs(env) == num_envs, "wrong number of envs", 0, 0);
+    check(obs_size == NUM_FEATURES * sizeof(int16_t), "wrong observation size", 0, 0);
+
+    /* Offset by one byte, as a slice of a larger buffer might be */
+    uint8_t *obs_memory = malloc(num_envs * obs_size + 1);
+    uint8_t *obs = obs_memory + 1;
+    uint8_t *first_obs = malloc(num_envs * obs_size);
+    int16_t *before = malloc(num_envs * NUM_FEATURES * sizeof(int16_t));
+    int16_t *after = malloc(NUM_FEATURES * sizeof(int16_t));
+    uint8_t *actions = malloc(num_envs);
+    float *reward = malloc(num_envs * sizeof(float));
+    uint8_t *done = malloc(num_envs);
+    size_t *episode_steps = calloc(num_envs, sizeof(size_t));
+    double *episode_reward = calloc(num_envs, sizeof(double));
+
+    sic_env_reset(env, NULL, obs);
+    memcpy(first_obs, obs, num_envs * obs_size);
+    for (size_t i = 0; i < num_envs; ++i)
+    {
+        features_read(obs + i * obs_size, before + i * NUM_FEATURES);
+        check(features_padding_zero(before + i * NUM_FEATURES), "nonzero padding after reset", i, 0);
+    }
+
+    size_t episodes = 0;
+    for (size_t step = 1; step <= steps; ++step)
+    {
+        for (size_t i = 0; i < num_envs; ++i)
+        {
+            actions[i] = aim ? policy_aim(before + i * NUM_FEATURES) : SIC_ACTION_NOOP;
+        }
+        sic_env_step(env, actions, obs, reward, done);
+
+        for (size_t i = 0; i < num_envs; ++i)
+        {
+            const uint8_t *env_obs = obs + i * obs_size;
+            features_read(env_obs, after);
+            check(features_padding_zero(after), "nonzero padding", i, step);
+
+            ++episode_steps[i];
+            episode_reward[i] += reward[i];
+
+            int live_aliens = 0;
+            for (size_t ai = 0; ai < MAX_ALIENS; ++ai)
+            {
+                live_aliens += before[i * NUM_FEATURES + F_ALIENS + 3 * ai] != 0;
+            }
+            int limit_reached = max_steps && episode_steps[i] == max_steps;
+
+            if (done[i])
+            {
+                ++episodes;
+                check(live_aliens == 0 || limit_reached, "done with aliens left before max_steps", i, step);
+                if (!limit_reached)
+                    check(episode_reward[i] == WAVE_SCORE, "cleared wave did not pay its score", i, step);
+                check(memcmp(env_obs, first_obs + i * obs_size, obs_size) == 0,
+                      "observation after done is not the first frame", i, step);
+                episode_steps[i] = 0;
+                episode_reward[i] = 0;
+            }
+            else
+            {
+                check(!limit_reached, "not done at max_steps", i, step);
+                check(reward[i] == features_kill_score(before + i * NUM_FEATURES, after),
+                      "reward differs from the score of the aliens hit", i, step);
+            }
+
+            memcpy(before + i * NUM_FEATURES, after, NUM_FEATURES * sizeof(int16_t));
+        }
+    }
+
+    free(episode_reward);
+    free(episode_steps);
+    free(done);
+    free(reward);
+    free(actions);
+    free(after);
+    free(before);
+    free(first_obs);
+    free(obs_memory);
+    sic_env_destroy(env);
+    return episodes;
+}
+
+int main(void)
+{
+    /* Idle players never clear the wave, so only max_steps ends episodes */
+    size_t idle = run(3, 1, 200, 1000, 0);
+    check(idle == 3 * 5, "max_steps did not end every episode", 0, 0);
+
+    /* Aiming players clear waves, spread over two threads */
+    size_t aimed = run(40, 2, 0, 1500, 1);
+    check(aimed >= 40, "not every env cleared its wave", 0, 0);
+
+    printf("%zu idle episodes, %zu cleared waves, %d failures\n", idle, aimed, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,298 @@
+// Builds an asset pack from text sources.
+//
+// usage: sic_pack <out.pack> <source.txt>...
+//
+// Sources are read line by line; blank lines and lines starting with '#' are
+// ignored. Statements:
+//
+//   sprite <name> <width> <height> [<count>]
+//       followed by height * count rows of width characters, '@' for a set
+//       pixel and '.' for a clear one. Frames follow each other.
+//   formation <name> <columns> <rows> <spacing x> <spacing y> <x> <y>
+//   types <type>...
+//       alien type (A, B or C) of each formation row, bottom row first.
+//   palette <name>
+//   color <background|text|ground|alien|player|bullet|bunker> <r> <g> <b>
+//
+// The pack is written next to the output and renamed over it, so a running
+// game never sees a half-written file.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "assets.h"
+
+struct PackItem
+{
+    AssetEntry entry;
+    std::vector<uint8_t> data;
+};
+
+struct Source
+{
+    const char *path;
+    std::ifstream in;
+    size_t line_number;
+};
+
+static bool source_error(const Source &source, const char *message)
+{
+    fprintf(stderr, "%s:%zu: %s\n", source.path, source.line_number, message);
+    return false;
+}
+
+// Next line that is neither blank nor a comment
+static bool source_next(Source *source, std::string *line)
+{
+    while (std::getline(source->in, *line))
+    {
+        ++source->line_number;
+        size_t start = line->find_first_not_of(" \t\r");
+        if (start == std::string::npos || (*line)[start] == '#')
+            continue;
+        size_t end = line->find_last_not_of(" \t\r");
+        *line = line->substr(start, end - start + 1);
+        return true;
+    }
+    return false;
+}
+
+static bool item_name_set(PackItem *item, const Source &source, const std::string &name)
+{
+    if (name.empty() || name.size() >= ASSET_NAME_SIZE)
+        return source_error(source, "missing or too long name");
+    memset(&item->entry, 0, sizeof(item->entry));
+    memcpy(item->entry.name, name.c_str(), name.size());
+    return true;
+}
+
+static bool parse_sprite(Source *source, std::istringstream &args, std::vector<PackItem> *items)
+{
+    std::string name;
+    uint32_t width = 0, height = 0, count = 1;
+    args >> name >> width >> height;
+    if (!args)
+        return source_error(*source, "expected: sprite <name> <width> <height> [<count>]");
+    if (!(args >> count))
+        count = 1;
+    if (width == 0 || height == 0 || count == 0)
+        return source_error(*source, "empty sprite");
+
+    PackItem item;
+    if (!item_name_set(&item, *source, name))
+        return false;
+    item.entry.type = ASSET_SPRITE;
+    item.entry.width = width;
+    item.entry.height = height;
+    item.entry.count = count;
+
+    std::string line;
+    for (size_t row = 0; row < (size_t)height * count; ++row)
+    {
+        if (!source_next(source, &line))
+            return source_error(*source, "sprite ends early");
+        if (line.size() != width || line.find_first_not_of("@.") != std::string::npos)
+            return source_error(*source, "sprite row must be width characters of '@' and '.'");
+        for (char c : line)
+        {
+            item.data.push_back(c == '@');
+        }
+    }
+
+    items->push_back(item);
+    return true;
+}
+
+static bool parse_formation(Source *source, std::istringstream &args, std::vector<PackItem> *items)
+{
+    std::string name;
+    AssetFormation formation;
+    uint32_t columns = 0, rows = 0;
+    args >> name >> columns >> rows >> formation.spacing_x >> formation.spacing_y >> formation.x >> formation.y;
+    if (!args)
+        return source_error(*source, "expected: formation <name> <columns> <rows> <spacing x> <spacing y> <x> <y>");
+    if (columns == 0 || rows == 0 || (size_t)columns * rows > GAME_MAX_ALIENS)
+        return source_error(*source, "formation must hold 1 to GAME_MAX_ALIENS aliens");
+
+    std::string line, keyword, type;
+    if (!source_next(source, &line))
+        return source_error(*source, "formation without types");
+    std::istringstream types(line);
+    types >> keyword;
+    if (keyword != "types")
+        return source_error(*source, "expected: types <type>...");
+
+    PackItem item;
+    if (!item_name_set(&item, *source, name))
+        return false;
+    item.entry.type = ASSET_FORMATION;
+    item.entry.width = columns;
+    item.entry.height = rows;
+    item.entry.count = 1;
+
+    const uint8_t *params = (const uint8_t *)&formation;
+    item.data.assign(params, params + sizeof(formation));
+    while (types >> type)
+    {
+        if (type != "A" && type != "B" && type != "C")
+            return source_error(*source, "alien type must be A, B or C");
+        item.data.push_back(ALIEN_TYPE_A + (type[0] - 'A'));
+    }
+    if (item.data.size() != sizeof(formation) + rows)
+        return source_error(*source, "need one type per formation row");
+
+    items->push_back(item);
+    return true;
+}
+
+static bool parse_palette(Source *source, std::istringstream &args, std::vector<PackItem> *items)
+{
+    static const char *color_names[PALETTE_NUM_COLORS] = {
+        "background", "text", "ground", "alien", "player", "bullet", "bunker"};
+
+    std::string name;
+    args >> name;
+
+    PackItem item;
+    if (!item_name_set(&item, *source, name))
+        return false;
+    item.entry.type = ASSET_PALETTE;
+    item.entry.count = PALETTE_NUM_COLORS;
+
+    uint32_t colors[PALETTE_NUM_COLORS];
+    bool set[PALETTE_NUM_COLORS] = {};
+    std::string line, keyword, color;
+    for (size_t i = 0; i < PALETTE_NUM_COLORS; ++i)
+    {
+        unsigned r, g, b;
+        if (!source_next(source, &line))
+            return source_error(*source, "palette ends early");
+        std::istringstream fields(line);
+        fields >> keyword >> color >> r >> g >> b;
+        if (!fields || keyword != "color" || r > 255 || g > 255 || b > 255)
+            return source_error(*source, "expected: color <name> <r> <g> <b>");
+
+        size_t index = 0;
+        while (index < PALETTE_NUM_COLORS && color != color_names[index])
+            ++index;
+        if (index == PALETTE_NUM_COLORS || set[index])
+            return source_error(*source, "unknown or repeated color");
+        colors[index] = rgb_to_uint32(r, g, b);
+        set[index] = true;
+    }
+
+    const uint8_t *bytes = (const uint8_t *)colors;
+    item.data.assign(bytes, bytes + sizeof(colors));
+    items->push_back(item);
+    return true;
+}
+
+static bool parse_source(const char *path, std::vector<PackItem> *items)
+{
+    Source source;
+    source.path = path;
+    source.in.open(path);
+    source.line_number = 0;
+    if (!source.in)
+    {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+
+    std::string line, keyword;
+    while (source_next(&source, &line))
+    {
+        std::istringstream args(line);
+        args >> keyword;
+
+        bool ok;
+        if (keyword == "sprite")
+            ok = parse_sprite(&source, args, items);
+        else if (keyword == "formation")
+            ok = parse_formation(&source, args, items);
+        else if (keyword == "palette")
+            ok = parse_palette(&source, args, items);
+        else
+            ok = source_error(source, "unknown statement");
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+static size_t align8(size_t offset)
+{
+    return (offset + 7) & ~(size_t)7;
+}
+
+static bool pack_write(const char *path, std::vector<PackItem> &items)
+{
+    AssetPackHeader header;
+    header.magic = ASSET_PACK_MAGIC;
+    header.version = ASSET_PACK_VERSION;
+    header.num_entries = items.size();
+    header.entries_offset = align8(sizeof(header));
+
+    size_t offset = align8(header.entries_offset + items.size() * sizeof(AssetEntry));
+    for (PackItem &item : items)
+    {
+        item.entry.offset = offset;
+        item.entry.size = item.data.size();
+        offset = align8(offset + item.data.size());
+    }
+
+    std::vector<uint8_t> pack(offset, 0);
+    memcpy(pack.data(), &header, sizeof(header));
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        memcpy(pack.data() + header.entries_offset + i * sizeof(AssetEntry), &items[i].entry, sizeof(AssetEntry));
+        memcpy(pack.data() + items[i].entry.offset, items[i].data.data(), items[i].data.size());
+    }
+
+    std::string tmp_path = std::string(path) + ".tmp";
+    FILE *file = fopen(tmp_path.c_str(), "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot open %s\n", tmp_path.c_str());
+        return false;
+    }
+    bool written = fwrite(pack.data(), 1, pack.size(), file) == pack.size();
+    written = fclose(file) == 0 && written;
+    if (!written || rename(tmp_path.c_str(), path) != 0)
+    {
+        fprintf(stderr, "Cannot write %s\n", path);
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <out.pack> <source.txt>...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<PackItem> items;
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!parse_source(argv[i], &items))
+            return 1;
+    }
+
+    if (!pack_write(argv[1], items))
+        return 1;
+
+    // Load it back the way the game does, so a pack that builds also loads
+    AssetPack pack;
+    if (!asset_pack_load(&pack, argv[1]))
+        return 1;
+    asset_pack_unload(&pack);
+    return 0;
+}
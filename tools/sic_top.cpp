@@ -0,0 +1,102 @@
+// Samples the live metrics of a running game from shared memory.
+//
+// usage: sic_top [-n name] [-i interval_ms] [-c count] [-r]
+//
+//   -n  shared memory name (default /sic_metrics, or SIC_METRICS)
+//   -i  milliseconds between samples (default 1000)
+//   -c  number of samples, 0 for no limit (default 0)
+//   -r  raw output: one line of name=value pairs per sample
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "metrics.h"
+
+static void print_table(const uint64_t *values, uint32_t pid, bool stalled)
+{
+    printf("pid %u  frame %llu%s\n", pid, (unsigned long long)values[METRIC_FRAMES], stalled ? "  (stalled)" : "");
+    printf("  frame time  p50 %7.3f ms  p95 %7.3f ms  p99 %7.3f ms  max %7.3f ms\n",
+           values[METRIC_FRAME_TIME_P50_NS] / 1e6, values[METRIC_FRAME_TIME_P95_NS] / 1e6,
+           values[METRIC_FRAME_TIME_P99_NS] / 1e6, values[METRIC_FRAME_TIME_MAX_NS] / 1e6);
+    printf("  sim %llu ticks/s  upload %.3f ms\n",
+           (unsigned long long)values[METRIC_SIM_TICKS_PER_SECOND], values[METRIC_UPLOAD_TIME_NS] / 1e6);
+    printf("  aliens %llu  bullets %llu  dropped bullets %llu  score %llu\n",
+           (unsigned long long)values[METRIC_LIVE_ALIENS], (unsigned long long)values[METRIC_BULLETS],
+           (unsigned long long)values[METRIC_DROPPED_BULLETS], (unsigned long long)values[METRIC_SCORE]);
+}
+
+static void print_raw(const uint64_t *values)
+{
+    for (size_t i = 0; i < METRIC_COUNT; ++i)
+    {
+        printf("%s%s=%llu", i ? " " : "", metric_names[i], (unsigned long long)values[i]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = getenv("SIC_METRICS");
+    if (!name)
+        name = METRICS_SHM_NAME;
+    long interval_ms = 1000;
+    long count = 0;
+    bool raw = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:i:c:r")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            name = optarg;
+            break;
+        case 'i':
+            interval_ms = atol(optarg);
+            break;
+        case 'c':
+            count = atol(optarg);
+            break;
+        case 'r':
+            raw = true;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n name] [-i interval_ms] [-c count] [-r]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const MetricsShared *shared = metrics_open(name);
+    if (!shared)
+    {
+        fprintf(stderr, "No metrics at %s; is the game running?\n", name);
+        return 1;
+    }
+
+    uint64_t values[METRIC_COUNT];
+    uint64_t last_frame = 0;
+    for (long sample = 0; count == 0 || sample < count; ++sample)
+    {
+        if (sample)
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+        if (!metrics_read(shared, values))
+        {
+            fprintf(stderr, "Metrics stayed busy; skipping sample\n");
+            continue;
+        }
+
+        if (raw)
+            print_raw(values);
+        else
+            print_table(values, shared->pid, sample && values[METRIC_FRAMES] == last_frame);
+        fflush(stdout);
+        last_frame = values[METRIC_FRAMES];
+    }
+
+    metrics_close(shared);
+    return 0;
+}